@@ -6,7 +6,13 @@
 #include <vector>
 
 #include "mesh_triangulation_2d.h"
+#include "mesh_triangulation_2d_bitset.h"
+#include "mesh_triangulation_2d_fixed.h"
+#include "mesh_triangulation_2d_half_edge.h"
+#include "point_set_crossings.h"
+#include "triangulation_crossings.h"
 #include "triangulation_flip_graph.h"
+#include "triangulation_reverse_search.h"
 #include "vec2.h"
 
 
@@ -24,19 +30,24 @@ struct PointSet2
                                                           {-2, -2}, {3, -2}, {-2, 2},  {-3, -3}, {1, -2},  {5, -2}};
 };
 
-using AbslC = MeshTriangulationAbslTraits;
-using StdC = MeshTriangulationDefaultTraits;
-using TbbC = MeshTriangulationTbbTraits;
+using AbslC = MeshTriangulation2D<MeshTriangulationAbslTraits>;
+using AbslC16 = MeshTriangulation2D<MeshTriangulationCompactTraits<MeshTriangulationAbslTraits, uint16_t>>;
+using AbslP = MeshTriangulation2D<MeshTriangulationPackedTraits<MeshTriangulationAbslTraits>>;
+using StdC = MeshTriangulation2D<MeshTriangulationDefaultTraits>;
+using TbbC = MeshTriangulation2D<MeshTriangulationTbbTraits>;
+using BitsetC = MeshTriangulation2DBitset<>;
+using FixedC = MeshTriangulation2DFixed<32>;
+using HalfEdgeC = MeshTriangulation2DHalfEdge;
 
 
-template<class Traits, class PointSet>
+template<class Mesh, class PointSet>
 static void BM_TriangulationFlipGraph(benchmark::State& state)
 {
     size_t const num_points = state.range(0);
     auto const   points_cref =
         std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
 
-    TriangulationFlipGraph<Traits> gr(points_cref);
+    TriangulationFlipGraph<Mesh> gr(points_cref);
     gr.generate_graph();
     gr.generate_graph();
 
@@ -46,13 +57,13 @@ static void BM_TriangulationFlipGraph(benchmark::State& state)
     }
 
     state.counters["nodes"] = benchmark::Counter(gr.nodes().size());
-    state.counters["edges"] = benchmark::Counter(gr.edges().size());
+    state.counters["edges"] = benchmark::Counter(gr.num_edges());
     state.counters["node_rate"] = benchmark::Counter(gr.nodes().size(), benchmark::Counter::kIsIterationInvariantRate);
-    state.counters["edge_rate"] = benchmark::Counter(gr.edges().size(), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["edge_rate"] = benchmark::Counter(gr.num_edges(), benchmark::Counter::kIsIterationInvariantRate);
 }
 
 
-template<class Traits, class PointSet>
+template<class Mesh, class PointSet>
 static void BM_ConcurrentTriangulationFlipGraph(benchmark::State& state)
 {
     size_t const num_threads = 8;
@@ -60,7 +71,7 @@ static void BM_ConcurrentTriangulationFlipGraph(benchmark::State& state)
     auto const   points_cref =
         std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
 
-    ConcurrentTriangulationFlipGraph<Traits> gr(points_cref);
+    ConcurrentTriangulationFlipGraph<Mesh> gr(points_cref);
     gr.generate_graph(num_threads);
     gr.generate_graph(num_threads);
 
@@ -70,9 +81,246 @@ static void BM_ConcurrentTriangulationFlipGraph(benchmark::State& state)
     }
 
     state.counters["nodes"] = benchmark::Counter(gr.nodes().size());
-    state.counters["edges"] = benchmark::Counter(gr.edges().size());
+    state.counters["edges"] = benchmark::Counter(gr.num_edges());
     state.counters["node_rate"] = benchmark::Counter(gr.nodes().size(), benchmark::Counter::kIsIterationInvariantRate);
-    state.counters["edge_rate"] = benchmark::Counter(gr.edges().size(), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["edge_rate"] = benchmark::Counter(gr.num_edges(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template<class Mesh, class PointSet>
+static void BM_ConcurrentTriangulationFlipGraphBatched(benchmark::State& state)
+{
+    size_t const num_threads = 8;
+    size_t const batch_size  = 32;
+    size_t const num_points  = state.range(0);
+    auto const   points_cref =
+        std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
+
+    ConcurrentTriangulationFlipGraph<Mesh> gr(points_cref);
+    gr.generate_graph(num_threads, batch_size);
+    gr.generate_graph(num_threads, batch_size);
+
+    for(auto _: state)
+    {
+        gr.generate_graph(num_threads, batch_size);
+    }
+
+    state.counters["nodes"] = benchmark::Counter(gr.nodes().size());
+    state.counters["edges"] = benchmark::Counter(gr.num_edges());
+    state.counters["node_rate"] = benchmark::Counter(gr.nodes().size(), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["edge_rate"] = benchmark::Counter(gr.num_edges(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+
+template<class Mesh, class PointSet, class GraphTraits>
+static void BM_ConcurrentTriangulationFlipGraphGraphTraits(benchmark::State& state)
+{
+    size_t const num_threads = 8;
+    size_t const num_points  = state.range(0);
+    auto const   points_cref =
+        std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
+
+    ConcurrentTriangulationFlipGraph<Mesh, GraphTraits> gr(points_cref);
+    gr.generate_graph(num_threads);
+    gr.generate_graph(num_threads);
+
+    for(auto _: state)
+    {
+        gr.generate_graph(num_threads);
+    }
+
+    state.counters["nodes"] = benchmark::Counter(gr.nodes().size());
+    state.counters["edges"] = benchmark::Counter(gr.num_edges());
+    state.counters["node_rate"] = benchmark::Counter(gr.nodes().size(), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["edge_rate"] = benchmark::Counter(gr.num_edges(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+
+template<class Mesh, class PointSet>
+static void BM_ConcurrentTriangulationFlipGraphOwnerEdges(benchmark::State& state)
+{
+    size_t const num_threads = 8;
+    size_t const num_points  = state.range(0);
+    auto const   points_cref =
+        std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
+
+    ConcurrentTriangulationFlipGraph<Mesh> gr(points_cref, FlipGraphEdgeMode::CanonicalOwner);
+    gr.generate_graph(num_threads);
+    gr.generate_graph(num_threads);
+
+    for(auto _: state)
+    {
+        gr.generate_graph(num_threads);
+    }
+
+    state.counters["nodes"] = benchmark::Counter(gr.nodes().size());
+    state.counters["edges"] = benchmark::Counter(gr.num_edges());
+    state.counters["node_rate"] = benchmark::Counter(gr.nodes().size(), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["edge_rate"] = benchmark::Counter(gr.num_edges(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+
+template<class Mesh, class PointSet>
+static void BM_ConcurrentTriangulationFlipGraphDelaunaySeed(benchmark::State& state)
+{
+    size_t const num_threads = 8;
+    size_t const num_points  = state.range(0);
+    auto const   points_cref =
+        std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
+
+    ConcurrentTriangulationFlipGraph<Mesh> gr(points_cref, FlipGraphEdgeMode::Deduplicated, FlipGraphSeed::Delaunay);
+    gr.generate_graph(num_threads);
+    gr.generate_graph(num_threads);
+
+    for(auto _: state)
+    {
+        gr.generate_graph(num_threads);
+    }
+
+    state.counters["nodes"] = benchmark::Counter(gr.nodes().size());
+    state.counters["edges"] = benchmark::Counter(gr.num_edges());
+    state.counters["node_rate"] = benchmark::Counter(gr.nodes().size(), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["edge_rate"] = benchmark::Counter(gr.num_edges(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template<class Mesh, class PointSet>
+static void BM_ConcurrentNodeTriangulationFlipGraph(benchmark::State& state)
+{
+    size_t const num_threads = 8;
+    size_t const num_points  = state.range(0);
+    auto const   points_cref =
+        std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
+
+    ConcurrentNodeTriangulationFlipGraph<Mesh> gr(points_cref);
+    gr.generate_graph(num_threads);
+    gr.generate_graph(num_threads);
+
+    for(auto _: state)
+    {
+        gr.generate_graph(num_threads);
+    }
+
+    state.counters["nodes"] = benchmark::Counter(gr.nodes().size());
+    state.counters["edges"] = benchmark::Counter(gr.num_edges());
+    state.counters["node_rate"] = benchmark::Counter(gr.nodes().size(), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["edge_rate"] = benchmark::Counter(gr.num_edges(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+
+template<class Mesh, class PointSet>
+static void BM_WorkStealingTriangulationFlipGraph(benchmark::State& state)
+{
+    size_t const num_threads = 8;
+    size_t const num_points  = state.range(0);
+    auto const   points_cref =
+        std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
+
+    WorkStealingTriangulationFlipGraph<Mesh> gr(points_cref);
+    gr.generate_graph(num_threads);
+    gr.generate_graph(num_threads);
+
+    for(auto _: state)
+    {
+        gr.generate_graph(num_threads);
+    }
+
+    state.counters["nodes"] = benchmark::Counter(gr.nodes().size());
+    state.counters["edges"] = benchmark::Counter(gr.num_edges());
+    state.counters["node_rate"] = benchmark::Counter(gr.nodes().size(), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["edge_rate"] = benchmark::Counter(gr.num_edges(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template<class Mesh, class PointSet>
+static void BM_ReverseSearchTriangulationEnumerator(benchmark::State& state)
+{
+    size_t const num_points = state.range(0);
+    auto const   points_cref =
+        std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
+
+    ReverseSearchTriangulationEnumerator<Mesh> en(points_cref);
+    en.enumerate();
+
+    for(auto _: state)
+    {
+        en.enumerate();
+    }
+
+    state.counters["nodes"] = benchmark::Counter(en.num_nodes());
+    state.counters["edges"] = benchmark::Counter(en.num_edges());
+    state.counters["node_rate"] = benchmark::Counter(en.num_nodes(), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["edge_rate"] = benchmark::Counter(en.num_edges(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template<class Mesh, class PointSet>
+static void BM_ParallelReverseSearchTriangulationEnumerator(benchmark::State& state)
+{
+    size_t const num_threads = 8;
+    size_t const num_points  = state.range(0);
+    auto const   points_cref =
+        std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
+
+    ParallelReverseSearchTriangulationEnumerator<Mesh> en(points_cref);
+    en.enumerate(num_threads);
+
+    for(auto _: state)
+    {
+        en.enumerate(num_threads);
+    }
+
+    state.counters["nodes"] = benchmark::Counter(en.num_nodes());
+    state.counters["edges"] = benchmark::Counter(en.num_edges());
+    state.counters["node_rate"] = benchmark::Counter(en.num_nodes(), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["edge_rate"] = benchmark::Counter(en.num_edges(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template<class PointSet>
+static void BM_PointSetCrossings(benchmark::State& state)
+{
+    size_t const num_points = state.range(0);
+    auto const   points_cref =
+        std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
+    auto const geometry = std::make_shared<PointSetGeometry const>(points_cref);
+
+    for(auto _: state)
+    {
+        PointSetCrossings crossings(geometry);
+        benchmark::DoNotOptimize(crossings.row_words());
+    }
+}
+
+// crossing queries of every node against the seed, and is_flip_of() for every flip of every node
+template<class Mesh, class PointSet>
+static void BM_TriangulationCrossings(benchmark::State& state)
+{
+    size_t const num_points = state.range(0);
+    auto const   points_cref =
+        std::make_shared<std::vector<Vec2>>(PointSet::value.begin(), PointSet::value.begin() + num_points);
+
+    TriangulationFlipGraph<Mesh> gr(points_cref);
+    gr.generate_graph();
+    std::vector<Mesh const*> const nodes(gr.nodes().begin(), gr.nodes().end());
+    PointSetCrossings const        crossings(nodes.front()->geometry());
+
+    size_t crossing_pairs = 0;
+    size_t distance       = 0;
+    size_t flips          = 0;
+    for(auto _: state)
+    {
+        crossing_pairs = 0;
+        distance       = 0;
+        flips          = 0;
+        for(auto const* node: nodes)
+        {
+            crossing_pairs += count_crossing_pairs(crossings, *nodes.front(), *node);
+            distance += flip_distance_lower_bound(*nodes.front(), *node);
+            for(auto const& edge: node->flippable())
+                flips += is_flip_of(crossings, *node, edge, node->opposite_edge(edge));
+        }
+    }
+
+    state.counters["nodes"]          = benchmark::Counter(nodes.size());
+    state.counters["crossing_pairs"] = benchmark::Counter(crossing_pairs);
+    state.counters["distance"]       = benchmark::Counter(distance);
+    state.counters["flips"]          = benchmark::Counter(flips);
 }
 
 BENCHMARK_TEMPLATE(BM_TriangulationFlipGraph, StdC, PointSet1)
@@ -83,6 +331,26 @@ BENCHMARK_TEMPLATE(BM_TriangulationFlipGraph, AbslC, PointSet1)
     ->Unit(benchmark::kMicrosecond)
     ->DenseRange(4, 18);
 
+BENCHMARK_TEMPLATE(BM_TriangulationFlipGraph, AbslC16, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_TriangulationFlipGraph, AbslP, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_TriangulationFlipGraph, BitsetC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_TriangulationFlipGraph, FixedC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_TriangulationFlipGraph, HalfEdgeC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
 BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraph, StdC, PointSet1)
     ->Unit(benchmark::kMicrosecond)
     ->DenseRange(4, 18);
@@ -91,6 +359,116 @@ BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraph, AbslC, PointSet1)
     ->Unit(benchmark::kMicrosecond)
     ->DenseRange(4, 18);
 
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraph, AbslC16, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraph, AbslP, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraph, BitsetC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraph, FixedC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraph, HalfEdgeC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraphBatched, AbslC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraphGraphTraits, AbslC, PointSet1, FlipGraphShardedTraits)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraphGraphTraits, BitsetC, PointSet1, FlipGraphShardedTraits)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraphGraphTraits, FixedC, PointSet1, FlipGraphShardedTraits)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraphGraphTraits, AbslC, PointSet1,
+                   FlipGraphShardedWorkStealingTraits)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraphGraphTraits, BitsetC, PointSet1,
+                   FlipGraphShardedWorkStealingTraits)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraphOwnerEdges, AbslC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraphOwnerEdges, BitsetC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraphDelaunaySeed, AbslC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTriangulationFlipGraphDelaunaySeed, HalfEdgeC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentNodeTriangulationFlipGraph, AbslC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ConcurrentNodeTriangulationFlipGraph, BitsetC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_WorkStealingTriangulationFlipGraph, AbslC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_WorkStealingTriangulationFlipGraph, BitsetC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ReverseSearchTriangulationEnumerator, AbslC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ReverseSearchTriangulationEnumerator, BitsetC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ReverseSearchTriangulationEnumerator, HalfEdgeC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ParallelReverseSearchTriangulationEnumerator, AbslC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_ParallelReverseSearchTriangulationEnumerator, BitsetC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_PointSetCrossings, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 18);
+
+BENCHMARK_TEMPLATE(BM_TriangulationCrossings, AbslC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 12);
+
+BENCHMARK_TEMPLATE(BM_TriangulationCrossings, BitsetC, PointSet1)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(4, 12);
+
 
 BENCHMARK_MAIN();
 
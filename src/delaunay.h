@@ -0,0 +1,49 @@
+#ifndef CONVEX_TRIANGULATIONS_DELAUNAY_HPP
+#define CONVEX_TRIANGULATIONS_DELAUNAY_HPP
+
+#include "mesh_cell.h"
+#include "orient2d.h"
+#include "vec2.h"
+
+#include <cstddef>
+#include <vector>
+
+
+// Delaunay predicates on top of any mesh exposing flippable() and opposite_edge().
+//
+// Cocircular points (e.g. lattices) make the Delaunay triangulation ambiguous, so the incircle test is evaluated under
+// a symbolic perturbation of the lifting |p|^2 + eps_i, where eps_i dominates eps_j for i < j. Every edge then is
+// either legal or illegal, the Delaunay triangulation is unique, and Lawson flips of illegal edges always reach it.
+//
+// Like the orientation predicates, the incircle test is exact for integral point sets (see has_integral_coordinates)
+// and keeps an epsilon band around zero otherwise; the mesh based functions take the choice from mesh.geometry().
+
+// sign of the incircle determinant of d against the counter-clockwise triangle (a, b, c): 1 inside, -1 outside, 0 on
+// the circle. The exact variant evaluates it in 128-bit integer arithmetic.
+int incircle_exact(Vec2 const& a, Vec2 const& b, Vec2 const& c, Vec2 const& d);
+int incircle_inexact(Vec2 const& a, Vec2 const& b, Vec2 const& c, Vec2 const& d);
+
+// whether d lies inside the circumcircle of the counter-clockwise triangle (a, b, c), under the perturbation above
+bool in_circumcircle_perturbed(std::vector<Vec2> const& coords, size_t a, size_t b, size_t c, size_t d, bool exact);
+
+// whether the flippable edge violates the (perturbed) empty circle property, illegal edges are always flippable
+template<class Mesh>
+bool is_illegal_edge(Mesh const& mesh, std::vector<Vec2> const& coords, EdgeCell const& edge);
+
+// illegal edge with the smallest EdgeCell::index(), undefined if the mesh is Delaunay; flipping it is the Lawson
+// parent of the triangulation
+template<class Mesh>
+EdgeCell lawson_flip_edge(Mesh const& mesh, std::vector<Vec2> const& coords);
+
+// whether edge is the Lawson flip edge of mesh, cheaper than comparing with lawson_flip_edge()
+template<class Mesh>
+bool is_lawson_flip_edge(Mesh const& mesh, std::vector<Vec2> const& coords, EdgeCell const& edge);
+
+// flip to the Delaunay triangulation, returns the number of flips
+template<class Mesh>
+size_t lawson_flip_to_delaunay(Mesh& mesh, std::vector<Vec2> const& coords);
+
+
+#include "delaunay.inl"
+
+#endif // CONVEX_TRIANGULATIONS_DELAUNAY_HPP
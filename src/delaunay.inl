@@ -0,0 +1,124 @@
+#ifndef DELAUNAY_INL
+#define DELAUNAY_INL
+
+#include "utils/float.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+
+inline int incircle_exact(Vec2 const& a, Vec2 const& b, Vec2 const& c, Vec2 const& d)
+{
+    int64_t const adx = static_cast<int64_t>(a.x) - static_cast<int64_t>(d.x);
+    int64_t const ady = static_cast<int64_t>(a.y) - static_cast<int64_t>(d.y);
+    int64_t const bdx = static_cast<int64_t>(b.x) - static_cast<int64_t>(d.x);
+    int64_t const bdy = static_cast<int64_t>(b.y) - static_cast<int64_t>(d.y);
+    int64_t const cdx = static_cast<int64_t>(c.x) - static_cast<int64_t>(d.x);
+    int64_t const cdy = static_cast<int64_t>(c.y) - static_cast<int64_t>(d.y);
+
+    using int128_t = __int128;
+
+    // the differences stay within 2^30, so the squared norms and the cross products within 2^61 and their products
+    // within 2^122, the determinant fits a 128-bit integer
+    int128_t const det = int128_t{adx * adx + ady * ady} * (bdx * cdy - bdy * cdx) -
+                         int128_t{bdx * bdx + bdy * bdy} * (adx * cdy - ady * cdx) +
+                         int128_t{cdx * cdx + cdy * cdy} * (adx * bdy - ady * bdx);
+    return (det > 0) - (det < 0);
+}
+
+
+inline int incircle_inexact(Vec2 const& a, Vec2 const& b, Vec2 const& c, Vec2 const& d)
+{
+    Vec2 const ad = a - d;
+    Vec2 const bd = b - d;
+    Vec2 const cd = c - d;
+
+    // incircle determinant, rows (p - d, |p - d|^2) for p = a, b, c
+    Vec2::float_type const det =
+        ad.norm2() * bd.cross(cd) - bd.norm2() * ad.cross(cd) + cd.norm2() * ad.cross(bd);
+    if(detail::is_same_epsilon(det, 0))
+        return 0;
+    return det > 0 ? 1 : -1;
+}
+
+
+inline bool in_circumcircle_perturbed(std::vector<Vec2> const& coords, size_t const a, size_t const b, size_t const c,
+                                      size_t const d, bool const exact)
+{
+    int const sign = exact ? incircle_exact(coords[a], coords[b], coords[c], coords[d])
+                           : incircle_inexact(coords[a], coords[b], coords[c], coords[d]);
+    if(sign != 0)
+        return sign > 0;
+
+    // cocircular: the sign is decided by the perturbation of the smallest vertex index, whose coefficient is the
+    // cofactor of its lifted coordinate; none of them vanish for the strictly convex quadrilateral of a flippable edge
+    size_t const lowest = std::min({a, b, c, d});
+    if(lowest == a)
+        return orient2d(coords[d], coords[b], coords[c], exact) > 0;
+    if(lowest == b)
+        return orient2d(coords[d], coords[a], coords[c], exact) < 0;
+    if(lowest == c)
+        return orient2d(coords[d], coords[a], coords[b], exact) > 0;
+    return orient2d(coords[a], coords[b], coords[c], exact) < 0;
+}
+
+
+template<class Mesh>
+bool is_illegal_edge(Mesh const& mesh, std::vector<Vec2> const& coords, EdgeCell const& edge)
+{
+    EdgeCell const opposite = mesh.opposite_edge(edge);
+    assert(!opposite.undefined());
+
+    bool const exact = mesh.geometry()->exact();
+    size_t     a     = edge.a;
+    size_t     b     = edge.b;
+    if(orient2d(coords[a], coords[b], coords[opposite.a], exact) < 0)
+        std::swap(a, b);
+    return in_circumcircle_perturbed(coords, a, b, opposite.a, opposite.b, exact);
+}
+
+
+template<class Mesh>
+EdgeCell lawson_flip_edge(Mesh const& mesh, std::vector<Vec2> const& coords)
+{
+    EdgeCell best;
+    for(auto const& edge: mesh.flippable())
+    {
+        if((best.undefined() || edge.index() < best.index()) && is_illegal_edge(mesh, coords, edge))
+            best = edge;
+    }
+    return best;
+}
+
+
+template<class Mesh>
+bool is_lawson_flip_edge(Mesh const& mesh, std::vector<Vec2> const& coords, EdgeCell const& edge)
+{
+    if(!is_illegal_edge(mesh, coords, edge))
+        return false;
+
+    size_t const idx = edge.index();
+    for(auto const& other: mesh.flippable())
+    {
+        if(other.index() < idx && is_illegal_edge(mesh, coords, other))
+            return false;
+    }
+    return true;
+}
+
+
+template<class Mesh>
+size_t lawson_flip_to_delaunay(Mesh& mesh, std::vector<Vec2> const& coords)
+{
+    size_t num_flips = 0;
+    for(EdgeCell edge = lawson_flip_edge(mesh, coords); !edge.undefined(); edge = lawson_flip_edge(mesh, coords))
+    {
+        [[maybe_unused]] auto const res = mesh.flip_edge(edge);
+        assert(res == Mesh::Result::Success);
+        ++num_flips;
+    }
+    return num_flips;
+}
+
+#endif // DELAUNAY_INL
@@ -0,0 +1,64 @@
+#ifndef CONVEX_TRIANGULATIONS_FLIPGRAPHCSR_HPP
+#define CONVEX_TRIANGULATIONS_FLIPGRAPHCSR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// Flip graph in compressed sparse row form: node i has the dense id i, its neighbours are
+// neighbours[offsets[i]] ... neighbours[offsets[i + 1] - 1], sorted. Every undirected edge is stored in both
+// directions. The triangulations themselves are not copied, nodes[i] points into the storage of the graph engine that
+// produced it and is only valid as long as that engine is neither destroyed nor regenerated.
+template<class Mesh>
+struct FlipGraphCSR
+{
+    using node_id = uint32_t;
+
+    class NeighbourRange
+    {
+    public:
+        NeighbourRange(node_id const* first, node_id const* last)
+            : first_(first),
+              last_(last)
+        {}
+
+        node_id const* begin() const { return first_; }
+        node_id const* end() const { return last_; }
+        size_t         size() const { return last_ - first_; }
+        bool           empty() const { return first_ == last_; }
+
+    private:
+        node_id const* first_;
+        node_id const* last_;
+    };
+
+    std::vector<Mesh const*> nodes;
+    std::vector<size_t>      offsets;
+    std::vector<node_id>     neighbours;
+
+    size_t num_nodes() const { return nodes.size(); }
+    size_t num_edges() const { return neighbours.size() / 2; }
+    size_t degree(node_id const id) const { return offsets[id + 1] - offsets[id]; }
+
+    NeighbourRange adjacent(node_id const id) const
+    {
+        return NeighbourRange(neighbours.data() + offsets[id], neighbours.data() + offsets[id + 1]);
+    }
+
+    // dense id of a node, nodes.size() if it is not part of the graph
+    node_id id_of(Mesh const* node) const;
+};
+
+
+// Assign dense ids to nodes (in address order, which follows the arena allocation order) and convert the pointer pair
+// edges into CSR form. The edges are the union of a deduplicated edge set and of per-worker buffers holding every
+// undirected edge once (see FlipGraphEdgeMode), either of them may be empty.
+template<class Mesh, class NodeSet, class EdgeSet, class EdgeBuffer>
+FlipGraphCSR<Mesh> make_flip_graph_csr(NodeSet const& nodes, EdgeSet const& edges,
+                                       std::vector<EdgeBuffer> const& edge_buffers);
+
+
+#include "flip_graph_csr.inl"
+
+#endif // CONVEX_TRIANGULATIONS_FLIPGRAPHCSR_HPP
@@ -0,0 +1,74 @@
+#ifndef FLIP_GRAPH_CSR_INL
+#define FLIP_GRAPH_CSR_INL
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <limits>
+
+
+template<class Mesh>
+typename FlipGraphCSR<Mesh>::node_id FlipGraphCSR<Mesh>::id_of(Mesh const* node) const
+{
+    auto const it = std::lower_bound(nodes.begin(), nodes.end(), node, std::less<Mesh const*>{});
+    if(it == nodes.end() || *it != node)
+        return static_cast<node_id>(nodes.size());
+    return static_cast<node_id>(it - nodes.begin());
+}
+
+
+template<class Mesh, class NodeSet, class EdgeSet, class EdgeBuffer>
+FlipGraphCSR<Mesh> make_flip_graph_csr(NodeSet const& nodes, EdgeSet const& edges,
+                                       std::vector<EdgeBuffer> const& edge_buffers)
+{
+    FlipGraphCSR<Mesh> csr;
+    assert(nodes.size() < std::numeric_limits<typename FlipGraphCSR<Mesh>::node_id>::max());
+
+    csr.nodes.assign(nodes.begin(), nodes.end());
+    std::sort(csr.nodes.begin(), csr.nodes.end(), std::less<Mesh const*>{});
+
+    size_t num_edges = edges.size();
+    for(auto const& edge_buffer: edge_buffers)
+        num_edges += edge_buffer.size();
+
+    // both endpoints of every recorded edge must be nodes, an unknown one would index past the offsets below
+    std::vector<std::pair<typename FlipGraphCSR<Mesh>::node_id, typename FlipGraphCSR<Mesh>::node_id>> id_edges;
+    id_edges.reserve(num_edges);
+    auto const add_edge = [&csr, &id_edges](Mesh const* lhs, Mesh const* rhs)
+    {
+        auto const lhs_id = csr.id_of(lhs);
+        auto const rhs_id = csr.id_of(rhs);
+        assert(lhs_id < csr.nodes.size() && rhs_id < csr.nodes.size());
+        id_edges.emplace_back(lhs_id, rhs_id);
+    };
+    for(auto const& [lhs, rhs]: edges)
+        add_edge(lhs, rhs);
+    for(auto const& edge_buffer: edge_buffers)
+        for(auto const& [lhs, rhs]: edge_buffer)
+            add_edge(lhs, rhs);
+
+    // count the degrees, then turn them into offsets with an exclusive prefix sum
+    csr.offsets.assign(csr.nodes.size() + 1, 0);
+    for(auto const& [lhs, rhs]: id_edges)
+    {
+        ++csr.offsets[lhs + 1];
+        ++csr.offsets[rhs + 1];
+    }
+    for(size_t i = 1; i < csr.offsets.size(); ++i)
+        csr.offsets[i] += csr.offsets[i - 1];
+
+    csr.neighbours.resize(csr.offsets.back());
+    std::vector<size_t> cursor(csr.offsets.begin(), csr.offsets.end() - 1);
+    for(auto const& [lhs, rhs]: id_edges)
+    {
+        csr.neighbours[cursor[lhs]++] = rhs;
+        csr.neighbours[cursor[rhs]++] = lhs;
+    }
+
+    for(size_t i = 0; i + 1 < csr.offsets.size(); ++i)
+        std::sort(csr.neighbours.begin() + csr.offsets[i], csr.neighbours.begin() + csr.offsets[i + 1]);
+
+    return csr;
+}
+
+#endif // FLIP_GRAPH_CSR_INL
@@ -10,21 +10,24 @@
 #include <vector>
 
 #include "mesh_triangulation_2d.h"
+#include "mesh_triangulation_2d_bitset.h"
+#include "mesh_triangulation_2d_fixed.h"
+#include "mesh_triangulation_2d_half_edge.h"
 #include "triangulation_flip_graph.h"
 #include "utils/timer.h"
 #include "vec2.h"
 
-template<class Traits>
+template<class Mesh>
 void run_measure(std::shared_ptr<std::vector<Vec2>> const& vec_ptr, std::string_view name)
 {
-    // TriangulationFlipGraph<Traits> gr(vec_ptr);
+    // TriangulationFlipGraph<Mesh> gr(vec_ptr);
     // gr.generate_graph();
     // gr.generate_graph();
     //
     // Timer<std::chrono::milliseconds>::MeasureRepeated<10>(fmt::format("TriangulationFlipGraph<{}>", name),
     //                                                       [&gr]() { gr.generate_graph(); });
 
-    ConcurrentTriangulationFlipGraph<Traits> gr2(vec_ptr);
+    ConcurrentTriangulationFlipGraph<Mesh> gr2(vec_ptr);
     gr2.generate_graph();
     gr2.generate_graph();
 
@@ -37,6 +40,31 @@ void run_measure(std::shared_ptr<std::vector<Vec2>> const& vec_ptr, std::string_
 }
 
 
+template<class Mesh>
+void run_count(std::shared_ptr<std::vector<Vec2>> const& vec_ptr, FlipGraphSeed const seed)
+{
+    TriangulationFlipGraphCounter<Mesh> counter(vec_ptr, seed);
+    auto const&                         counts = counter.count();
+
+    fmt::println("Triangulations: {}", counts.num_nodes);
+    fmt::println("Flip edges: {}", counts.num_edges);
+    fmt::println("Degree histogram: {}", counts.degree_histogram);
+}
+
+
+template<class Mesh>
+size_t run_graph(std::shared_ptr<std::vector<Vec2>> const& vec_ptr, FlipGraphSeed const seed)
+{
+    ConcurrentTriangulationFlipGraph<Mesh> gr(vec_ptr, FlipGraphEdgeMode::Deduplicated, seed);
+    gr.generate_graph();
+    return gr.nodes().size();
+}
+
+
+// triangle-array mesh for point sets above the fixed-capacity meshes, flips there are dominated by hash-map probing
+using LargeMesh = MeshTriangulation2DHalfEdge;
+
+
 int main(int argc, char** argv)
 {
     CLI::App app{"App description"};
@@ -48,6 +76,14 @@ int main(int argc, char** argv)
                            ->delimiter(',')
                            ->type_name("FLOAT FLOAT, FLOAT FLOAT,");
 
+    bool count_only = false;
+    app.add_flag("--count-only", count_only,
+                 "Only count triangulations and flip edges, without keeping the triangulations in memory.");
+
+    bool delaunay_seed = false;
+    app.add_flag("--delaunay-seed", delaunay_seed,
+                 "Start the exploration from the Delaunay triangulation instead of the sweep-hull triangulation.");
+
     argv = app.ensure_utf8(argv);
     try
     {
@@ -67,12 +103,31 @@ int main(int argc, char** argv)
     auto const coord_ptr = std::make_shared<std::vector<Vec2>>(std::move_iterator<iter_t>(vec.begin()),
                                                                std::move_iterator<iter_t>(vec.end()));
 
-    // run_measure<MeshTriangulationDefaultTraits>(coord_ptr, "Std");
-    // run_measure<MeshTriangulationAbslTraits>(coord_ptr, "Absl");
-    // run_measure<MeshTriangulationTbbTraits>(coord_ptr, "Tbb");
+    FlipGraphSeed const seed = delaunay_seed ? FlipGraphSeed::Delaunay : FlipGraphSeed::SweepHull;
 
-    ConcurrentTriangulationFlipGraph<MeshTriangulationAbslTraits> gr2(coord_ptr);
-    gr2.generate_graph();
+    // point sets up to 64 points use the inline fixed-capacity mesh, sized for the point set, larger ones LargeMesh
+    if(count_only)
+    {
+        auto const count = [&coord_ptr, seed](auto tag) { run_count<typename decltype(tag)::type>(coord_ptr, seed); };
+        if(!dispatch_fixed_mesh(coord_ptr->size(), count))
+            run_count<LargeMesh>(coord_ptr, seed);
+        return 0;
+    }
+
+    // run_measure<MeshTriangulation2D<MeshTriangulationDefaultTraits>>(coord_ptr, "Std");
+    // run_measure<MeshTriangulation2D<MeshTriangulationAbslTraits>>(coord_ptr, "Absl");
+    // run_measure<MeshTriangulation2D<MeshTriangulationTbbTraits>>(coord_ptr, "Tbb");
+    // run_measure<MeshTriangulation2DBitset<>>(coord_ptr, "Bitset");
+
+    size_t     num_nodes = 0;
+    auto const graph     = [&coord_ptr, &num_nodes, seed](auto tag)
+    { num_nodes = run_graph<typename decltype(tag)::type>(coord_ptr, seed); };
+    if(!dispatch_fixed_mesh(coord_ptr->size(), graph))
+        num_nodes = run_graph<LargeMesh>(coord_ptr, seed);
+
+#if TRIANGULATION_FLIP_GRAPH_DEBUG_FINGERPRINT
+    fmt::println("Fingerprint false positives: {}", MeshTriangulation2DCRefEqualTo::false_positives());
+#endif
 
-    return gr2.nodes().size() > 0 ? 0 : 1;
+    return num_nodes > 0 ? 0 : 1;
 }
@@ -1,49 +1,143 @@
 #ifndef CONVEX_TRIANGULATIONS_MESHCELLS_HPP
 #define CONVEX_TRIANGULATIONS_MESHCELLS_HPP
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <fmt/format.h>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Mesh cells are templated on the vertex index type, so that meshes over small point sets can store uint8_t or
+// uint16_t indices. The largest index value is the undefined sentinel (-1ull for size_t); the constructors take size_t
+// indices and map -1ull to the sentinel of the narrower type. Widening a cell is implicit, narrowing is explicit.
+template<class Index = size_t>
+class BasicEdgeCell
+{
+    static_assert(std::is_unsigned_v<Index>, "BasicEdgeCell requires an unsigned index type");
+
+public:
+    using index_type                       = Index;
+    static constexpr Index undefined_index = std::numeric_limits<Index>::max();
+
+    Index a{};
+    Index b{};
+
+    explicit constexpr BasicEdgeCell(size_t i = -1ull, size_t j = -1ull)
+        : a(static_cast<Index>(std::min(i, j))),
+          b(static_cast<Index>(std::max(i, j)))
+    {}
+
+    template<class Other, std::enable_if_t<(sizeof(Other) < sizeof(Index)), int> = 0>
+    constexpr BasicEdgeCell(BasicEdgeCell<Other> const& other)
+        : BasicEdgeCell(widen(other.a), widen(other.b))
+    {}
+
+    template<class Other, std::enable_if_t<(sizeof(Other) > sizeof(Index)), int> = 0>
+    explicit constexpr BasicEdgeCell(BasicEdgeCell<Other> const& other)
+        : BasicEdgeCell(widen(other.a), widen(other.b))
+    {}
+
+    constexpr bool undefined() const { return b == undefined_index || a == undefined_index; };
+
+    // position of the edge in the enumeration (0,1), (0,2), (1,2), (0,3), ... of all candidate edges
+    constexpr size_t index() const { return size_t{b} * (size_t{b} - 1) / 2 + a; }
+
+    constexpr bool operator<(const BasicEdgeCell& rhs) const { return (a != rhs.a) ? a < rhs.a : b < rhs.b; }
+    constexpr bool operator==(const BasicEdgeCell& rhs) const { return a == rhs.a && b == rhs.b; }
+
+private:
+    template<class Other>
+    static constexpr size_t widen(Other const v)
+    {
+        return v == std::numeric_limits<Other>::max() ? -1ull : size_t{v};
+    }
+};
+
+using EdgeCell = BasicEdgeCell<size_t>;
+
+template<class Index>
+struct fmt::formatter<BasicEdgeCell<Index>>
+{
+    constexpr const char* parse(format_parse_context& ctx) const { return ctx.begin(); }
+    template<typename FormatContext>
+    typename FormatContext::iterator format(BasicEdgeCell<Index> const& cell, FormatContext& ctx) const
+    {
+        return fmt::format_to(ctx.out(), (cell.b == cell.undefined_index) ? "({},_)" : "({},{})", cell.a, cell.b);
+    }
+};
+
 
-class EdgeCell
+// Edge packed into a single 32-bit word, the larger vertex in the high and the smaller in the low 16 bits; 0xffff
+// is the undefined vertex. Canonicalization is branchless, equality is a single integer compare and the ordering of
+// the words is the EdgeCell::index() order, so keys can be hashed, compared and sorted as plain integers.
+class EdgeKey
 {
 public:
-    size_t a{};
-    size_t b{};
+    explicit constexpr EdgeKey(size_t i = -1ull, size_t j = -1ull)
+        : value_(pack(static_cast<uint16_t>(i), static_cast<uint16_t>(j)))
+    {}
 
-    explicit constexpr EdgeCell(size_t i = -1ull, size_t j = -1ull)
-        : a(std::min(i, j)),
-          b(std::max(i, j))
+    template<class Index>
+    explicit constexpr EdgeKey(BasicEdgeCell<Index> const& edge)
+        : EdgeKey(edge.undefined() ? -1ull : size_t{edge.a}, edge.undefined() ? -1ull : size_t{edge.b})
     {}
 
-    constexpr bool undefined() const { return b == -1ull || a == -1ull; };
+    constexpr operator EdgeCell() const { return EdgeCell(widen(a()), widen(b())); }
 
-    constexpr bool operator<(const EdgeCell& rhs) const { return (a != b) ? a < rhs.a : b < rhs.b; }
-    constexpr bool operator==(const EdgeCell& rhs) const { return a == rhs.a && b == rhs.b; }
+    constexpr uint32_t value() const { return value_; }
+    constexpr size_t   a() const { return value_ & 0xffffu; }
+    constexpr size_t   b() const { return value_ >> 16; }
+
+    constexpr bool   undefined() const { return b() == 0xffffu; };
+    constexpr size_t index() const { return b() * (b() - 1) / 2 + a(); }
+
+    constexpr bool operator<(EdgeKey const& rhs) const { return value_ < rhs.value_; }
+    constexpr bool operator==(EdgeKey const& rhs) const { return value_ == rhs.value_; }
+    constexpr bool operator!=(EdgeKey const& rhs) const { return value_ != rhs.value_; }
+
+private:
+    uint32_t value_;
+
+    static constexpr uint32_t pack(uint32_t const i, uint32_t const j)
+    {
+        // all-ones mask iff j < i, swapping the two through xor without a branch
+        uint32_t const swap = (i ^ j) & (0u - static_cast<uint32_t>(j < i));
+        return ((j ^ swap) << 16) | (i ^ swap);
+    }
+
+    static constexpr size_t widen(size_t const v) { return v == 0xffffu ? -1ull : v; }
 };
 
 template<>
-struct fmt::formatter<EdgeCell>
+struct fmt::formatter<EdgeKey> : fmt::formatter<EdgeCell>
 {
-    constexpr const char* parse(format_parse_context& ctx) const { return ctx.begin(); }
     template<typename FormatContext>
-    typename FormatContext::iterator format(EdgeCell const& cell, FormatContext& ctx) const
+    typename FormatContext::iterator format(EdgeKey const& key, FormatContext& ctx) const
     {
-        return fmt::format_to(ctx.out(), (cell.b == -1ull) ? "({},_)" : "({},{})", cell.a, cell.b);
+        return fmt::formatter<EdgeCell>::format(EdgeCell(key), ctx);
     }
 };
 
 
-class TriangleCell
+template<class Index = size_t>
+class BasicTriangleCell
 {
+    static_assert(std::is_unsigned_v<Index>, "BasicTriangleCell requires an unsigned index type");
+
 public:
-    size_t a;
-    size_t b;
-    size_t c;
-
-    explicit constexpr TriangleCell(size_t i = -1ul, size_t j = -1ul, size_t k = -1ul)
-        : a(i),
-          b(j),
-          c(k)
+    using index_type                       = Index;
+    static constexpr Index undefined_index = std::numeric_limits<Index>::max();
+
+    Index a;
+    Index b;
+    Index c;
+
+    explicit constexpr BasicTriangleCell(size_t i = -1ull, size_t j = -1ull, size_t k = -1ull)
+        : a(static_cast<Index>(i)),
+          b(static_cast<Index>(j)),
+          c(static_cast<Index>(k))
     {
         if(a > b)
             std::swap(a, b);
@@ -53,9 +147,10 @@ public:
             std::swap(a, b);
     }
 
-    constexpr bool undefined() const { return c == -1ull || b == -1ull || a == -1ull; };
+    constexpr bool undefined() const { return c == undefined_index || b == undefined_index || a == undefined_index; };
 
-    constexpr size_t opposite_point(EdgeCell const& l) const
+    // vertex opposite to the edge l of the triangle, -1ull if l is not an edge of it
+    constexpr size_t opposite_point(BasicEdgeCell<Index> const& l) const
     {
         if(l.undefined())
             return -1ull;
@@ -73,19 +168,24 @@ public:
         return -1ull;
     };
 
-    constexpr bool operator<(const TriangleCell& rhs) const
+    constexpr bool operator<(const BasicTriangleCell& rhs) const
     {
         return a != rhs.a ? a < rhs.a : (b != rhs.b ? b < rhs.b : c < rhs.c);
     };
-    constexpr bool operator==(const TriangleCell& rhs) const { return a == rhs.a && b == rhs.b && c == rhs.c; };
+    constexpr bool operator==(const BasicTriangleCell& rhs) const
+    {
+        return a == rhs.a && b == rhs.b && c == rhs.c;
+    };
 };
 
-template<>
-struct fmt::formatter<TriangleCell>
+using TriangleCell = BasicTriangleCell<size_t>;
+
+template<class Index>
+struct fmt::formatter<BasicTriangleCell<Index>>
 {
     constexpr const char* parse(format_parse_context& ctx) const { return ctx.begin(); }
     template<typename FormatContext>
-    typename FormatContext::iterator format(TriangleCell const& cell, FormatContext& ctx) const
+    typename FormatContext::iterator format(BasicTriangleCell<Index> const& cell, FormatContext& ctx) const
     {
         return fmt::format_to(ctx.out(), "({},{},{})", cell.a, cell.b, cell.c);
     }
@@ -5,22 +5,38 @@
 #define MESH_TRIANGULATION_HAS_TBB 1
 #define MESH_TRIANGULATION_HAS_ABSL 1
 
+#include "delaunay.h"
 #include "mesh_cell.h"
+#include "point_set_geometry.h"
 #include "utils/hash.h"
 #include "vec2.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 struct EdgeCellHash
 {
-    constexpr size_t operator()(EdgeCell const& eg) const noexcept { return HashUtils::combine(eg.a, eg.b); }
+    template<class Index>
+    constexpr size_t operator()(BasicEdgeCell<Index> const& eg) const noexcept
+    {
+        return HashUtils::combine(eg.a, eg.b);
+    }
+
+    constexpr size_t operator()(EdgeKey const& key) const noexcept { return HashUtils::mix(key.value()); }
 };
 
 
+// Mesh traits select the hash containers, the vertex index type stored in them and the key type of the edge
+// containers, see MeshTriangulationCompactTraits for narrow indices and MeshTriangulationPackedTraits for EdgeKey.
 struct MeshTriangulationDefaultTraits
 {
+    using index_type    = size_t;
+    using edge_key_type = BasicEdgeCell<size_t>;
+
     template<class... Args>
     using unordered_set_t = std::unordered_set<Args...>;
     template<class... Args>
@@ -40,6 +56,9 @@ struct MeshTriangulationDefaultTraits
 
 struct MeshTriangulationTbbTraits
 {
+    using index_type    = size_t;
+    using edge_key_type = BasicEdgeCell<size_t>;
+
     template<class... Args>
     using unordered_set_t = tbb::concurrent_unordered_set<Args...>;
     template<class... Args>
@@ -60,6 +79,9 @@ struct MeshTriangulationTbbTraits
 
 struct MeshTriangulationAbslTraits
 {
+    using index_type    = size_t;
+    using edge_key_type = BasicEdgeCell<size_t>;
+
     template<class... Args>
     using unordered_set_t = absl::flat_hash_set<Args...>;
     template<class... Args>
@@ -74,6 +96,25 @@ struct MeshTriangulationAbslTraits
 #endif
 
 
+// Containers of BaseTraits with narrow vertex indices, e.g. uint16_t shrinks an edge_adjacency entry from 32 to 8
+// bytes. Point sets must have fewer points than the largest Index value, which is the undefined sentinel.
+template<class BaseTraits, class Index>
+struct MeshTriangulationCompactTraits : BaseTraits
+{
+    using index_type    = Index;
+    using edge_key_type = BasicEdgeCell<Index>;
+};
+
+// Containers of BaseTraits keyed on the packed 32-bit EdgeKey: hashing mixes a single word instead of combining two
+// fields and key equality is one integer compare. Point sets must have fewer than 65535 points.
+template<class BaseTraits>
+struct MeshTriangulationPackedTraits : BaseTraits
+{
+    using index_type    = uint16_t;
+    using edge_key_type = EdgeKey;
+};
+
+
 
 template<class Traits = MeshTriangulationDefaultTraits>
 class MeshTriangulation2D
@@ -86,35 +127,65 @@ public:
         FailedFlipBorderEdge,
         FailedNotEnoughPoints,
         FailedSweepHullSort,
-        FailedUpdateAdjacency
+        FailedUpdateAdjacency,
+        FailedTooManyPoints
     };
 
     using float_type      = Vec2::float_type;
     using traits          = Traits;
-    using unordered_set_t = typename Traits::template unordered_set_t<EdgeCell, EdgeCellHash>;
-    using unordered_map_t = typename Traits::template unordered_map_t<EdgeCell, EdgeCell, EdgeCellHash>;
+    using index_type      = typename Traits::index_type;
+    using edge_cell_t     = BasicEdgeCell<index_type>;
+    using edge_key_t      = typename Traits::edge_key_type;
+    using unordered_set_t = typename Traits::template unordered_set_t<edge_key_t, EdgeCellHash>;
+    using unordered_map_t = typename Traits::template unordered_map_t<edge_key_t, edge_cell_t, EdgeCellHash>;
 
     explicit MeshTriangulation2D(std::shared_ptr<std::vector<Vec2> const> pts)
-        : coords_ptr_(std::move(pts)) {};
+        : geometry_(std::make_shared<PointSetGeometry const>(std::move(pts))) {};
+    explicit MeshTriangulation2D(std::shared_ptr<PointSetGeometry const> geometry)
+        : geometry_(std::move(geometry)) {};
 
     Result triangulate();
     Result flip_edge(EdgeCell edge);
 
+    // Lawson flips of illegal edges (see delaunay.h) up to the Delaunay triangulation, which unlike the result of
+    // triangulate() does not depend on the sweep-hull pivot; returns the number of flips
+    size_t make_delaunay();
+
     unordered_map_t const& edge_adjacency() const { return edge_adjacency_; }
     unordered_set_t const& flippable() const { return flippable_; }
 
+    // diagonal replacing edge when it is flipped, undefined for unknown or border edges
+    EdgeCell opposite_edge(EdgeCell const& edge) const
+    {
+        auto const it = edge_adjacency_.find(edge_key_t(edge));
+        return it == edge_adjacency_.end() ? EdgeCell() : EdgeCell(it->second);
+    }
+
+    // Identity of the triangulation: a bitset over all n(n-1)/2 candidate edges (see EdgeCell::index) and an
+    // order-independent hash of the same edge set, both maintained incrementally on every flip. Unlike the flippable
+    // set, the edge set identifies the triangulation uniquely, also with collinear points.
+    std::vector<uint64_t> const& canonical_key() const { return edge_bits_; }
+    Fingerprint128 const&        fingerprint() const { return fingerprint_; }
+    bool operator==(MeshTriangulation2D const& rhs) const { return edge_bits_ == rhs.edge_bits_; }
+
+    std::shared_ptr<PointSetGeometry const> const& geometry() const { return geometry_; }
+
 private:
-    unordered_map_t                          edge_adjacency_;
-    unordered_set_t                          flippable_;
-    std::shared_ptr<std::vector<Vec2> const> coords_ptr_;
+    unordered_map_t                         edge_adjacency_;
+    unordered_set_t                         flippable_;
+    std::shared_ptr<PointSetGeometry const> geometry_;
+    std::vector<uint64_t>                   edge_bits_;
+    Fingerprint128                          fingerprint_{};
+
+    void insert_edge_key(EdgeCell const& edge);
+    void erase_edge_key(EdgeCell const& edge);
 
     bool sweep_hull_sort(std::vector<size_t>& idxs, size_t start = 0) const;
     void sweep_hull_add(std::vector<size_t>& hull, std::vector<size_t> const& idxs);
     void insert_or_update_adjacency(TriangleCell const& t);
     bool replace_adjacency(EdgeCell const& edge, size_t from, size_t to);
 
-    bool       is_convex_polygon(EdgeCell const& edge, EdgeCell const& opposite) const;
-    float_type triangle_area(size_t a, size_t b, size_t c) const;
+    bool is_convex_polygon(EdgeCell const& edge, EdgeCell const& opposite) const;
 };
 
 // include inline implementation details
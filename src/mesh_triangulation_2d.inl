@@ -1,21 +1,16 @@
 #ifndef MESH_TRIANGULATION_2D_INL
 #define MESH_TRIANGULATION_2D_INL
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <numeric>
 #include <vector>
 #include "utils/algorithm.h"
+#include "utils/float.h"
 
 namespace detail
 {
-    template<class T, class U>
-    bool is_same_epsilon(T a, U b)
-    {
-        using diff_t = std::common_type_t<T, U>;
-        diff_t const max_epsilon =
-            std::max<diff_t>(std::numeric_limits<T>::epsilon(), std::numeric_limits<U>::epsilon());
-        diff_t const diff = std::abs(a - b);
-        return diff < 3 * max_epsilon;
-    }
-
     template<class T>
     struct VectorCircularHelper
     {
@@ -56,21 +51,24 @@ namespace detail
 template<class Traits>
 inline typename MeshTriangulation2D<Traits>::Result MeshTriangulation2D<Traits>::flip_edge(EdgeCell edge)
 {
-    auto const it = edge_adjacency_.find(edge);
+    edge_key_t const key(edge);
+    auto const       it = edge_adjacency_.find(key);
     if(it == edge_adjacency_.end())
         return Result::FailedEdgeNotFound;
 
-    auto const flip_it = flippable_.find(edge);
+    auto const flip_it = flippable_.find(key);
     if(flip_it == flippable_.end())
         return Result::FailedFlipBorderEdge;
 
     auto const opposite = it->second;
 
     traits::erase(edge_adjacency_, it);
-    edge_adjacency_.emplace(opposite, edge);
+    edge_adjacency_.emplace(edge_key_t(opposite), edge_cell_t(edge));
+    erase_edge_key(edge);
+    insert_edge_key(EdgeCell(opposite));
 
     traits::erase(flippable_, flip_it);
-    flippable_.emplace(opposite);
+    flippable_.emplace(edge_key_t(opposite));
 
     bool succ = true;
     succ &= replace_adjacency(EdgeCell(edge.a, opposite.a), edge.b, opposite.b);
@@ -85,58 +83,53 @@ inline typename MeshTriangulation2D<Traits>::Result MeshTriangulation2D<Traits>:
 template<class Traits>
 inline bool MeshTriangulation2D<Traits>::replace_adjacency(EdgeCell const& edge, size_t from_idx, size_t to_idx)
 {
-    auto const it = edge_adjacency_.find(edge);
+    edge_key_t const key(edge);
+    auto const       it = edge_adjacency_.find(key);
     if(it == edge_adjacency_.end())
         return false;
 
     auto const old_opposite = it->second;
 
     if(old_opposite.a == from_idx)
-        it->second = EdgeCell(to_idx, old_opposite.b);
+        it->second = edge_cell_t(to_idx, old_opposite.b);
     else if(old_opposite.b == from_idx)
-        it->second = EdgeCell(old_opposite.a, to_idx);
+        it->second = edge_cell_t(old_opposite.a, to_idx);
     else // not found
         return false;
 
-    auto const new_opposite = it->second;
+    EdgeCell const new_opposite(it->second);
     if(new_opposite.undefined() || !is_convex_polygon(edge, new_opposite))
-        traits::erase(flippable_, edge);
+        traits::erase(flippable_, key);
     else
-        flippable_.emplace(edge);
+        flippable_.emplace(key);
 
     return true;
 }
 
 
 template<class Traits>
-inline typename MeshTriangulation2D<Traits>::float_type MeshTriangulation2D<Traits>::triangle_area(size_t a, size_t b,
-                                                                                                   size_t c) const
+inline void MeshTriangulation2D<Traits>::insert_edge_key(EdgeCell const& edge)
 {
-    assert(coords_ptr_);
-    auto const& coords = *coords_ptr_;
-
-    float_type const ab_norm2      = (coords[a] - coords[b]).norm2();
-    float_type const ac_norm2      = (coords[a] - coords[c]).norm2();
-    float_type const bc_norm2      = (coords[b] - coords[c]).norm2();
-    float_type const ac2_minus_bc2 = ac_norm2 - bc_norm2;
+    size_t const idx = edge.index();
+    edge_bits_[idx / 64] |= uint64_t{1} << (idx % 64);
+    fingerprint_ += HashUtils::unordered_element128(idx);
+}
 
-    float_type const triangle_area2 =
-        0.5 * (-ab_norm2 * ab_norm2 - ac2_minus_bc2 * ac2_minus_bc2 + 2.0 * ab_norm2 * (ac_norm2 + bc_norm2));
 
-    return std::sqrt(triangle_area2);
+template<class Traits>
+inline void MeshTriangulation2D<Traits>::erase_edge_key(EdgeCell const& edge)
+{
+    size_t const idx = edge.index();
+    edge_bits_[idx / 64] &= ~(uint64_t{1} << (idx % 64));
+    fingerprint_ -= HashUtils::unordered_element128(idx);
 }
 
 
 template<class Traits>
 inline bool MeshTriangulation2D<Traits>::is_convex_polygon(EdgeCell const& edge, EdgeCell const& opposite) const
 {
-    float_type const t1   = triangle_area(edge.a, edge.b, opposite.a);
-    float_type const t2   = triangle_area(edge.a, edge.b, opposite.b);
-    float_type const t1_f = triangle_area(opposite.a, opposite.b, edge.a);
-    float_type const t2_f = triangle_area(opposite.a, opposite.b, edge.b);
-
-    return detail::is_same_epsilon(t1 + t2, t1_f + t2_f) && !detail::is_same_epsilon(t1_f, 0) &&
-           !detail::is_same_epsilon(t2_f, 0);
+    assert(geometry_);
+    return geometry_->is_strictly_convex_quadrilateral(edge, opposite);
 }
 
 
@@ -144,12 +137,18 @@ template<class Traits>
 inline typename MeshTriangulation2D<Traits>::Result MeshTriangulation2D<Traits>::triangulate()
 {
     edge_adjacency_.clear();
+    flippable_.clear();
+    fingerprint_ = Fingerprint128{};
 
-    assert(coords_ptr_);
-    auto const&  coords      = *coords_ptr_;
+    assert(geometry_);
+    auto const&  coords      = geometry_->coords();
     size_t const coords_size = coords.size();
     if(coords_size < 3)
         return Result::FailedNotEnoughPoints;
+    if(coords_size >= edge_cell_t::undefined_index)
+        return Result::FailedTooManyPoints;
+
+    edge_bits_.assign((coords_size * (coords_size - 1) / 2 + 63) / 64, 0);
 
     std::vector<size_t> idxs(coords_size);
     std::iota(idxs.begin(), idxs.end(), 0);
@@ -168,8 +167,8 @@ inline typename MeshTriangulation2D<Traits>::Result MeshTriangulation2D<Traits>:
 template<class Traits>
 inline bool MeshTriangulation2D<Traits>::sweep_hull_sort(std::vector<size_t>& idxs, size_t start) const
 {
-    assert(coords_ptr_);
-    auto const&  coords = *coords_ptr_;
+    assert(geometry_);
+    auto const&  coords = geometry_->coords();
     size_t const n      = idxs.size();
 
     size_t pivot = start;
@@ -225,8 +224,8 @@ inline bool MeshTriangulation2D<Traits>::sweep_hull_sort(std::vector<size_t>& id
 template<class Traits>
 inline void MeshTriangulation2D<Traits>::sweep_hull_add(std::vector<size_t>& hull, std::vector<size_t> const& idxs)
 {
-    assert(coords_ptr_);
-    auto const& coords = *coords_ptr_;
+    assert(geometry_);
+    auto const& coords = geometry_->coords();
 
     assert(idxs.size() == coords.size());
     assert(idxs.size() >= 3);
@@ -271,19 +270,20 @@ inline void MeshTriangulation2D<Traits>::insert_or_update_adjacency(TriangleCell
         auto&& eg           = eg_op_pair.first;
         auto&& opposite_idx = eg_op_pair.second;
 
-        auto const it = edge_adjacency_.find(eg);
+        auto const it = edge_adjacency_.find(edge_key_t(eg));
         if(it == edge_adjacency_.end())
         {
-            edge_adjacency_.emplace(eg, EdgeCell(opposite_idx, -1ull));
+            edge_adjacency_.emplace(edge_key_t(eg), edge_cell_t(opposite_idx, -1ull));
+            insert_edge_key(eg);
             continue;
         }
 
         auto& opposite_eg = it->second;
         if(opposite_eg.undefined())
         {
-            opposite_eg = EdgeCell(opposite_eg.a, opposite_idx);
-            if(is_convex_polygon(eg, opposite_eg))
-                flippable_.emplace(eg);
+            opposite_eg = edge_cell_t(opposite_eg.a, opposite_idx);
+            if(is_convex_polygon(eg, EdgeCell(opposite_eg)))
+                flippable_.emplace(edge_key_t(eg));
         }
         else
         {
@@ -295,4 +295,12 @@ inline void MeshTriangulation2D<Traits>::insert_or_update_adjacency(TriangleCell
     }
 }
 
+
+template<class Traits>
+inline size_t MeshTriangulation2D<Traits>::make_delaunay()
+{
+    assert(geometry_);
+    return lawson_flip_to_delaunay(*this, geometry_->coords());
+}
+
 #endif // MESH_TRIANGULATION_2D_INL
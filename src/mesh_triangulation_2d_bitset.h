@@ -0,0 +1,154 @@
+#ifndef CONVEX_TRIANGULATIONS_MESHTRIANGULATION2DBITSET_HPP
+#define CONVEX_TRIANGULATIONS_MESHTRIANGULATION2DBITSET_HPP
+
+#include "mesh_cell.h"
+#include "mesh_triangulation_2d.h"
+#include "point_set_geometry.h"
+#include "utils/bits.h"
+#include "utils/hash.h"
+#include "vec2.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+
+// Triangulation stored as a bitset over the n(n-1)/2 candidate edges of the point set, plus a second bitset marking
+// the flippable ones. Copies are a fixed number of words with no heap allocation, at the cost of an O(n) scan to
+// recover the two triangles adjacent to an edge.
+template<size_t MaxPoints = 64>
+class MeshTriangulation2DBitset
+{
+    static_assert(MaxPoints >= 3 && MaxPoints <= 256, "MeshTriangulation2DBitset supports 3 to 256 points");
+
+    using word_t                      = uint64_t;
+    static constexpr size_t word_bits = 64;
+
+public:
+    using Result     = MeshTriangulation2D<>::Result;
+    using float_type = Vec2::float_type;
+
+    static constexpr size_t max_points = MaxPoints;
+    static constexpr size_t max_edges  = MaxPoints * (MaxPoints - 1) / 2;
+    static constexpr size_t num_words  = (max_edges + word_bits - 1) / word_bits;
+
+    using bitset_t = std::array<word_t, num_words>;
+
+    // forward range over the set bits of an edge bitset, decoded back into EdgeCell
+    class EdgeRange
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = EdgeCell;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = EdgeCell;
+
+            iterator(bitset_t const* bits, size_t word_idx)
+                : bits_(bits),
+                  word_idx_(word_idx),
+                  word_(word_idx < num_words ? (*bits)[word_idx] : 0)
+            {
+                skip_empty_words();
+            }
+
+            EdgeCell operator*() const
+            {
+                return edge_from_index(word_idx_ * word_bits + BitUtils::countr_zero(word_));
+            }
+            iterator& operator++()
+            {
+                word_ &= word_ - 1;
+                skip_empty_words();
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator==(iterator const& rhs) const { return word_idx_ == rhs.word_idx_ && word_ == rhs.word_; }
+            bool operator!=(iterator const& rhs) const { return !(*this == rhs); }
+
+        private:
+            bitset_t const* bits_;
+            size_t          word_idx_;
+            word_t          word_;
+
+            void skip_empty_words()
+            {
+                while(word_ == 0 && ++word_idx_ < num_words)
+                    word_ = (*bits_)[word_idx_];
+                if(word_idx_ >= num_words)
+                    word_idx_ = num_words;
+            }
+        };
+
+        explicit EdgeRange(bitset_t const& bits)
+            : bits_(&bits)
+        {}
+
+        iterator begin() const { return iterator(bits_, 0); }
+        iterator end() const { return iterator(bits_, num_words); }
+        size_t   size() const;
+        bool     empty() const { return size() == 0; }
+
+    private:
+        bitset_t const* bits_;
+    };
+
+    explicit MeshTriangulation2DBitset(std::shared_ptr<std::vector<Vec2> const> pts)
+        : geometry_(std::make_shared<PointSetGeometry const>(std::move(pts))) {};
+    explicit MeshTriangulation2DBitset(std::shared_ptr<PointSetGeometry const> geometry)
+        : geometry_(std::move(geometry)) {};
+
+    Result triangulate();
+    Result flip_edge(EdgeCell edge);
+
+    EdgeRange edges() const { return EdgeRange(edges_); }
+    EdgeRange flippable() const { return EdgeRange(flippable_); }
+
+    bool contains(EdgeCell const& edge) const
+    {
+        return edge.a != edge.b && edge.b < max_points && test(edges_, edge_index(edge));
+    }
+    EdgeCell opposite_edge(EdgeCell const& edge) const;
+
+    // order-independent hash of the edge set, maintained incrementally on every flip
+    Fingerprint128 const& fingerprint() const { return fingerprint_; }
+    bitset_t const&       canonical_key() const { return edges_; }
+    bool                  operator==(MeshTriangulation2DBitset const& rhs) const { return edges_ == rhs.edges_; }
+
+    std::shared_ptr<PointSetGeometry const> const& geometry() const { return geometry_; }
+
+    static constexpr size_t edge_index(EdgeCell const& edge) { return edge.index(); }
+    static EdgeCell         edge_from_index(size_t idx);
+
+private:
+    std::shared_ptr<PointSetGeometry const> geometry_;
+    bitset_t                                edges_{};
+    bitset_t                                flippable_{};
+    Fingerprint128                          fingerprint_{};
+
+    static bool test(bitset_t const& bits, size_t idx) { return (bits[idx / word_bits] >> (idx % word_bits)) & 1u; }
+    static void set(bitset_t& bits, size_t idx) { bits[idx / word_bits] |= word_t{1} << (idx % word_bits); }
+    static void reset(bitset_t& bits, size_t idx) { bits[idx / word_bits] &= ~(word_t{1} << (idx % word_bits)); }
+
+    void insert_edge(size_t idx);
+    void erase_edge(size_t idx);
+    void update_flippable(EdgeCell const& edge);
+    bool is_convex_polygon(EdgeCell const& edge, EdgeCell const& opposite) const;
+};
+
+// include inline implementation details
+#include "mesh_triangulation_2d_bitset.inl"
+
+#endif // CONVEX_TRIANGULATIONS_MESHTRIANGULATION2DBITSET_HPP
@@ -0,0 +1,177 @@
+#ifndef MESH_TRIANGULATION_2D_BITSET_INL
+#define MESH_TRIANGULATION_2D_BITSET_INL
+
+#include <array>
+#include <cassert>
+#include <limits>
+
+namespace detail
+{
+    struct EdgeIndexPair
+    {
+        uint8_t a;
+        uint8_t b;
+    };
+
+    template<size_t NumEdges>
+    constexpr std::array<EdgeIndexPair, NumEdges> make_edge_index_table()
+    {
+        std::array<EdgeIndexPair, NumEdges> table{};
+        size_t                              idx = 0;
+        for(size_t b = 1; idx < NumEdges; ++b)
+            for(size_t a = 0; a < b && idx < NumEdges; ++a, ++idx)
+                table[idx] = EdgeIndexPair{static_cast<uint8_t>(a), static_cast<uint8_t>(b)};
+        return table;
+    }
+} // namespace detail
+
+
+template<size_t MaxPoints>
+inline size_t MeshTriangulation2DBitset<MaxPoints>::EdgeRange::size() const
+{
+    size_t count = 0;
+    for(auto const word: *bits_)
+        count += BitUtils::popcount(word);
+    return count;
+}
+
+
+template<size_t MaxPoints>
+inline EdgeCell MeshTriangulation2DBitset<MaxPoints>::edge_from_index(size_t const idx)
+{
+    static constexpr auto table = detail::make_edge_index_table<max_edges>();
+    assert(idx < max_edges);
+    return EdgeCell(table[idx].a, table[idx].b);
+}
+
+
+template<size_t MaxPoints>
+inline void MeshTriangulation2DBitset<MaxPoints>::insert_edge(size_t const idx)
+{
+    set(edges_, idx);
+    fingerprint_ += HashUtils::unordered_element128(idx);
+}
+
+
+template<size_t MaxPoints>
+inline void MeshTriangulation2DBitset<MaxPoints>::erase_edge(size_t const idx)
+{
+    reset(edges_, idx);
+    fingerprint_ -= HashUtils::unordered_element128(idx);
+}
+
+
+template<size_t MaxPoints>
+inline typename MeshTriangulation2DBitset<MaxPoints>::Result MeshTriangulation2DBitset<MaxPoints>::triangulate()
+{
+    edges_.fill(0);
+    flippable_.fill(0);
+    fingerprint_ = Fingerprint128{};
+
+    assert(geometry_);
+    if(geometry_->size() > max_points)
+        return Result::FailedTooManyPoints;
+
+    // the sweep-hull construction is shared with the hash-map mesh, only its result is converted
+    MeshTriangulation2D<> seed(geometry_);
+    auto const            res = seed.triangulate();
+    if(res != Result::Success)
+        return res;
+
+    for(auto const& [edge, opposite]: seed.edge_adjacency())
+    {
+        insert_edge(edge_index(edge));
+        if(!opposite.undefined() && is_convex_polygon(edge, opposite))
+            set(flippable_, edge_index(edge));
+    }
+
+    return Result::Success;
+}
+
+
+template<size_t MaxPoints>
+inline typename MeshTriangulation2DBitset<MaxPoints>::Result
+MeshTriangulation2DBitset<MaxPoints>::flip_edge(EdgeCell const edge)
+{
+    if(!contains(edge))
+        return Result::FailedEdgeNotFound;
+
+    size_t const idx = edge_index(edge);
+    if(!test(flippable_, idx))
+        return Result::FailedFlipBorderEdge;
+
+    EdgeCell const opposite = opposite_edge(edge);
+    if(opposite.undefined())
+        return Result::FailedUpdateAdjacency;
+
+    // the quadrilateral is unchanged by the flip, so the new diagonal is flippable back
+    erase_edge(idx);
+    reset(flippable_, idx);
+    insert_edge(edge_index(opposite));
+    set(flippable_, edge_index(opposite));
+
+    update_flippable(EdgeCell(edge.a, opposite.a));
+    update_flippable(EdgeCell(edge.a, opposite.b));
+    update_flippable(EdgeCell(edge.b, opposite.a));
+    update_flippable(EdgeCell(edge.b, opposite.b));
+
+    return Result::Success;
+}
+
+
+template<size_t MaxPoints>
+inline EdgeCell MeshTriangulation2DBitset<MaxPoints>::opposite_edge(EdgeCell const& edge) const
+{
+    assert(geometry_);
+    auto const&  coords = geometry_->coords();
+    size_t const n      = coords.size();
+
+    // among the common neighbours of a and b on each side of the edge, the adjacent triangle is the one with the
+    // smallest area, any other candidate triangle would contain it
+    size_t     left       = -1ull;
+    size_t     right      = -1ull;
+    float_type left_area  = std::numeric_limits<float_type>::infinity();
+    float_type right_area = std::numeric_limits<float_type>::infinity();
+    for(size_t v = 0; v < n; ++v)
+    {
+        if(v == edge.a || v == edge.b || !contains(EdgeCell(edge.a, v)) || !contains(EdgeCell(edge.b, v)))
+            continue;
+
+        float_type const cross = Vec2::cross(coords[edge.a], coords[edge.b], coords[v]);
+        if(cross > 0 && cross < left_area)
+        {
+            left_area = cross;
+            left      = v;
+        }
+        else if(cross < 0 && -cross < right_area)
+        {
+            right_area = -cross;
+            right      = v;
+        }
+    }
+
+    return EdgeCell(left, right);
+}
+
+
+template<size_t MaxPoints>
+inline void MeshTriangulation2DBitset<MaxPoints>::update_flippable(EdgeCell const& edge)
+{
+    size_t const   idx      = edge_index(edge);
+    EdgeCell const opposite = opposite_edge(edge);
+    if(opposite.undefined() || !is_convex_polygon(edge, opposite))
+        reset(flippable_, idx);
+    else
+        set(flippable_, idx);
+}
+
+
+template<size_t MaxPoints>
+inline bool MeshTriangulation2DBitset<MaxPoints>::is_convex_polygon(EdgeCell const& edge,
+                                                                    EdgeCell const& opposite) const
+{
+    assert(geometry_);
+    return geometry_->is_strictly_convex_quadrilateral(edge, opposite);
+}
+
+#endif // MESH_TRIANGULATION_2D_BITSET_INL
@@ -0,0 +1,111 @@
+#ifndef CONVEX_TRIANGULATIONS_MESHTRIANGULATION2DFIXED_HPP
+#define CONVEX_TRIANGULATIONS_MESHTRIANGULATION2DFIXED_HPP
+
+#include "mesh_cell.h"
+#include "mesh_triangulation_2d.h"
+#include "mesh_triangulation_2d_bitset.h"
+#include "point_set_geometry.h"
+#include "utils/hash.h"
+#include "vec2.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+// Triangulation of at most N points with all storage inline: the edge and flippable bitsets of
+// MeshTriangulation2DBitset plus, for every candidate edge, the two opposite vertices as a uint8_t edge cell.
+// Unlike the bitset mesh, opposite_edge() is a table lookup instead of an O(n) scan, and unlike the hash-map mesh,
+// copies and flips never allocate. Pick N with dispatch_fixed_mesh() once the point set is known.
+//
+// The mesh does not own its PointSetGeometry, so that it stays trivially copyable: a copy is a plain copy of its words,
+// without touching a reference count shared by all the nodes of a graph. Whoever builds the mesh keeps the geometry
+// alive for the mesh and all of its copies, e.g. the graph engines, which build one geometry per point set.
+template<size_t N>
+class MeshTriangulation2DFixed
+{
+    static_assert(N >= 3 && N <= 64, "MeshTriangulation2DFixed supports 3 to 64 points");
+
+    using Bitset_t = MeshTriangulation2DBitset<N>;
+
+public:
+    using Result     = MeshTriangulation2D<>::Result;
+    using float_type = Vec2::float_type;
+    using bitset_t   = typename Bitset_t::bitset_t;
+    using EdgeRange  = typename Bitset_t::EdgeRange;
+
+    using edge_cell_t = BasicEdgeCell<uint8_t>;
+
+    static constexpr size_t max_points = N;
+    static constexpr size_t max_edges  = Bitset_t::max_edges;
+
+    explicit MeshTriangulation2DFixed(std::shared_ptr<PointSetGeometry const> const& geometry)
+        : geometry_(geometry.get()) {};
+    // a temporary geometry would be gone before the mesh
+    explicit MeshTriangulation2DFixed(std::shared_ptr<PointSetGeometry const>&&) = delete;
+
+    Result triangulate();
+    Result flip_edge(EdgeCell edge);
+
+    EdgeRange edges() const { return EdgeRange(edges_); }
+    EdgeRange flippable() const { return EdgeRange(flippable_); }
+
+    bool contains(EdgeCell const& edge) const
+    {
+        return edge.a != edge.b && edge.b < max_points && test(edges_, edge_index(edge));
+    }
+    EdgeCell opposite_edge(EdgeCell const& edge) const;
+
+    // order-independent hash of the edge set, maintained incrementally on every flip
+    Fingerprint128 const& fingerprint() const { return fingerprint_; }
+    bitset_t const&       canonical_key() const { return edges_; }
+    bool                  operator==(MeshTriangulation2DFixed const& rhs) const { return edges_ == rhs.edges_; }
+
+    PointSetGeometry const* geometry() const { return geometry_; }
+
+    static constexpr size_t edge_index(EdgeCell const& edge) { return edge.index(); }
+    static EdgeCell         edge_from_index(size_t idx) { return Bitset_t::edge_from_index(idx); }
+
+private:
+    PointSetGeometry const*            geometry_;
+    bitset_t                           edges_{};
+    bitset_t                           flippable_{};
+    std::array<edge_cell_t, max_edges> opposite_; // meaningful for the edges of the triangulation only
+    Fingerprint128                     fingerprint_{};
+
+    static bool test(bitset_t const& bits, size_t idx) { return (bits[idx / 64] >> (idx % 64)) & 1u; }
+    static void set(bitset_t& bits, size_t idx) { bits[idx / 64] |= uint64_t{1} << (idx % 64); }
+    static void reset(bitset_t& bits, size_t idx) { bits[idx / 64] &= ~(uint64_t{1} << (idx % 64)); }
+
+    void insert_edge(size_t idx, EdgeCell const& opposite);
+    void erase_edge(size_t idx);
+    bool replace_adjacency(EdgeCell const& edge, size_t from, size_t to);
+};
+
+
+static_assert(std::is_trivially_copyable_v<MeshTriangulation2DFixed<16>> &&
+                  std::is_trivially_copyable_v<MeshTriangulation2DFixed<32>> &&
+                  std::is_trivially_copyable_v<MeshTriangulation2DFixed<64>>,
+              "MeshTriangulation2DFixed copies must not touch anything outside the mesh");
+
+
+// Type tag passed to the callable of dispatch_fixed_mesh.
+template<class Mesh>
+struct MeshTag
+{
+    using type = Mesh;
+};
+
+// call f(MeshTag<MeshTriangulation2DFixed<N>>{}) with the smallest supported N >= num_points (16, 32 or 64), return
+// false without calling f if the point set is larger than that
+template<class F>
+bool dispatch_fixed_mesh(size_t num_points, F&& f);
+
+
+// include inline implementation details
+#include "mesh_triangulation_2d_fixed.inl"
+
+#endif // CONVEX_TRIANGULATIONS_MESHTRIANGULATION2DFIXED_HPP
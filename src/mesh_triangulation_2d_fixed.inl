@@ -0,0 +1,132 @@
+#ifndef MESH_TRIANGULATION_2D_FIXED_INL
+#define MESH_TRIANGULATION_2D_FIXED_INL
+
+#include <cassert>
+#include <utility>
+
+
+template<size_t N>
+inline typename MeshTriangulation2DFixed<N>::Result MeshTriangulation2DFixed<N>::triangulate()
+{
+    edges_.fill(0);
+    flippable_.fill(0);
+    fingerprint_ = Fingerprint128{};
+
+    assert(geometry_);
+    if(geometry_->size() > max_points)
+        return Result::FailedTooManyPoints;
+
+    // the sweep-hull construction is shared with the hash-map mesh, only its result is converted
+    // the seed mesh only borrows the geometry as well, a shared_ptr without owner does not manage it
+    MeshTriangulation2D<> seed(std::shared_ptr<PointSetGeometry const>(std::shared_ptr<void>(), geometry_));
+    auto const            res = seed.triangulate();
+    if(res != Result::Success)
+        return res;
+
+    for(auto const& [edge, opposite]: seed.edge_adjacency())
+    {
+        insert_edge(edge_index(edge), opposite);
+        if(!opposite.undefined() && geometry_->is_strictly_convex_quadrilateral(edge, opposite))
+            set(flippable_, edge_index(edge));
+    }
+
+    return Result::Success;
+}
+
+
+template<size_t N>
+inline typename MeshTriangulation2DFixed<N>::Result MeshTriangulation2DFixed<N>::flip_edge(EdgeCell const edge)
+{
+    if(!contains(edge))
+        return Result::FailedEdgeNotFound;
+
+    size_t const idx = edge_index(edge);
+    if(!test(flippable_, idx))
+        return Result::FailedFlipBorderEdge;
+
+    EdgeCell const opposite = opposite_edge(edge);
+
+    // the quadrilateral is unchanged by the flip, so the new diagonal is flippable back
+    erase_edge(idx);
+    reset(flippable_, idx);
+    insert_edge(edge_index(opposite), edge);
+    set(flippable_, edge_index(opposite));
+
+    bool succ = true;
+    succ &= replace_adjacency(EdgeCell(edge.a, opposite.a), edge.b, opposite.b);
+    succ &= replace_adjacency(EdgeCell(edge.a, opposite.b), edge.b, opposite.a);
+    succ &= replace_adjacency(EdgeCell(edge.b, opposite.a), edge.a, opposite.b);
+    succ &= replace_adjacency(EdgeCell(edge.b, opposite.b), edge.a, opposite.a);
+
+    return succ ? Result::Success : Result::FailedUpdateAdjacency;
+}
+
+
+template<size_t N>
+inline EdgeCell MeshTriangulation2DFixed<N>::opposite_edge(EdgeCell const& edge) const
+{
+    if(!contains(edge))
+        return EdgeCell();
+
+    return opposite_[edge_index(edge)];
+}
+
+
+template<size_t N>
+inline void MeshTriangulation2DFixed<N>::insert_edge(size_t const idx, EdgeCell const& opposite)
+{
+    set(edges_, idx);
+    opposite_[idx] = edge_cell_t(opposite);
+    fingerprint_ += HashUtils::unordered_element128(idx);
+}
+
+
+template<size_t N>
+inline void MeshTriangulation2DFixed<N>::erase_edge(size_t const idx)
+{
+    reset(edges_, idx);
+    fingerprint_ -= HashUtils::unordered_element128(idx);
+}
+
+
+template<size_t N>
+inline bool MeshTriangulation2DFixed<N>::replace_adjacency(EdgeCell const& edge, size_t const from_idx,
+                                                           size_t const to_idx)
+{
+    size_t const idx = edge_index(edge);
+    if(!test(edges_, idx))
+        return false;
+
+    auto& cell = opposite_[idx];
+    if(cell.a == from_idx)
+        cell = edge_cell_t(to_idx, cell.b);
+    else if(cell.b == from_idx)
+        cell = edge_cell_t(cell.a, to_idx);
+    else // not found
+        return false;
+
+    EdgeCell const new_opposite(cell);
+    if(new_opposite.undefined() || !geometry_->is_strictly_convex_quadrilateral(edge, new_opposite))
+        reset(flippable_, idx);
+    else
+        set(flippable_, idx);
+
+    return true;
+}
+
+
+template<class F>
+bool dispatch_fixed_mesh(size_t const num_points, F&& f)
+{
+    if(num_points <= 16)
+        std::forward<F>(f)(MeshTag<MeshTriangulation2DFixed<16>>{});
+    else if(num_points <= 32)
+        std::forward<F>(f)(MeshTag<MeshTriangulation2DFixed<32>>{});
+    else if(num_points <= 64)
+        std::forward<F>(f)(MeshTag<MeshTriangulation2DFixed<64>>{});
+    else
+        return false;
+    return true;
+}
+
+#endif // MESH_TRIANGULATION_2D_FIXED_INL
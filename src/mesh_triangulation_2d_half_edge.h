@@ -0,0 +1,163 @@
+#ifndef CONVEX_TRIANGULATIONS_MESHTRIANGULATION2DHALFEDGE_HPP
+#define CONVEX_TRIANGULATIONS_MESHTRIANGULATION2DHALFEDGE_HPP
+
+#include "mesh_cell.h"
+#include "mesh_triangulation_2d.h"
+#include "point_set_geometry.h"
+#include "utils/bits.h"
+#include "utils/hash.h"
+#include "vec2.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <vector>
+
+
+// Triangulation stored as a flat triangle array in half-edge form: triangle t owns the half-edges 3t, 3t+1, 3t+2 in
+// counter-clockwise order, each half-edge records its origin vertex and its twin in the adjacent triangle. A flip
+// rewrites the two triangles of the edge in place and relinks the four outer twins, with no hashing and no allocation.
+// The half-edge of an EdgeCell is found by rotating around edge.a from one of its outgoing half-edges, i.e. in
+// O(degree) steps over contiguous memory instead of the five hash lookups of MeshTriangulation2D::flip_edge().
+class MeshTriangulation2DHalfEdge
+{
+public:
+    using Result      = MeshTriangulation2D<>::Result;
+    using float_type  = Vec2::float_type;
+    using half_edge_t = uint32_t;
+
+    static constexpr half_edge_t no_half_edge = std::numeric_limits<half_edge_t>::max();
+
+    struct HalfEdge
+    {
+        half_edge_t origin;
+        half_edge_t twin; // no_half_edge on the border
+    };
+
+    // forward range over the flippable edges, decoded from the flippable half-edge bitset
+    class EdgeRange
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = EdgeCell;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = EdgeCell;
+
+            iterator(MeshTriangulation2DHalfEdge const* mesh, size_t word_idx)
+                : mesh_(mesh),
+                  word_idx_(word_idx),
+                  word_(word_idx < mesh->flippable_.size() ? mesh->flippable_[word_idx] : 0)
+            {
+                skip_empty_words();
+            }
+
+            EdgeCell operator*() const
+            {
+                return mesh_->edge_of(static_cast<half_edge_t>(word_idx_ * 64 + BitUtils::countr_zero(word_)));
+            }
+            iterator& operator++()
+            {
+                word_ &= word_ - 1;
+                skip_empty_words();
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator==(iterator const& rhs) const { return word_idx_ == rhs.word_idx_ && word_ == rhs.word_; }
+            bool operator!=(iterator const& rhs) const { return !(*this == rhs); }
+
+        private:
+            MeshTriangulation2DHalfEdge const* mesh_;
+            size_t                             word_idx_;
+            uint64_t                           word_;
+
+            void skip_empty_words()
+            {
+                size_t const num_words = mesh_->flippable_.size();
+                while(word_ == 0 && ++word_idx_ < num_words)
+                    word_ = mesh_->flippable_[word_idx_];
+                if(word_idx_ >= num_words)
+                    word_idx_ = num_words;
+            }
+        };
+
+        explicit EdgeRange(MeshTriangulation2DHalfEdge const& mesh)
+            : mesh_(&mesh)
+        {}
+
+        iterator begin() const { return iterator(mesh_, 0); }
+        iterator end() const { return iterator(mesh_, mesh_->flippable_.size()); }
+        size_t   size() const;
+        bool     empty() const { return size() == 0; }
+
+    private:
+        MeshTriangulation2DHalfEdge const* mesh_;
+    };
+
+    explicit MeshTriangulation2DHalfEdge(std::shared_ptr<std::vector<Vec2> const> pts)
+        : geometry_(std::make_shared<PointSetGeometry const>(std::move(pts))) {};
+    explicit MeshTriangulation2DHalfEdge(std::shared_ptr<PointSetGeometry const> geometry)
+        : geometry_(std::move(geometry)) {};
+
+    Result triangulate();
+    Result flip_edge(EdgeCell edge);
+
+    EdgeRange flippable() const { return EdgeRange(*this); }
+
+    bool contains(EdgeCell const& edge) const
+    {
+        return edge.a != edge.b && edge.b < outgoing_.size() && test(edge_bits_, edge.index());
+    }
+    EdgeCell opposite_edge(EdgeCell const& edge) const;
+
+    // same identity as MeshTriangulation2D: candidate edge bitset and order-independent hash of the edge set
+    std::vector<uint64_t> const& canonical_key() const { return edge_bits_; }
+    Fingerprint128 const&        fingerprint() const { return fingerprint_; }
+    bool operator==(MeshTriangulation2DHalfEdge const& rhs) const { return edge_bits_ == rhs.edge_bits_; }
+
+    std::shared_ptr<PointSetGeometry const> const& geometry() const { return geometry_; }
+
+    std::vector<HalfEdge> const& half_edges() const { return half_edges_; }
+
+private:
+    std::shared_ptr<PointSetGeometry const> geometry_;
+    std::vector<HalfEdge>                   half_edges_;
+    std::vector<half_edge_t>                outgoing_;  // some half-edge starting at each vertex
+    std::vector<uint64_t>                   flippable_; // bit of the smaller half-edge of every flippable edge
+    std::vector<uint64_t>                   edge_bits_;
+    Fingerprint128                          fingerprint_{};
+
+    static bool test(std::vector<uint64_t> const& bits, size_t idx) { return (bits[idx / 64] >> (idx % 64)) & 1u; }
+    static void set(std::vector<uint64_t>& bits, size_t idx) { bits[idx / 64] |= uint64_t{1} << (idx % 64); }
+    static void reset(std::vector<uint64_t>& bits, size_t idx) { bits[idx / 64] &= ~(uint64_t{1} << (idx % 64)); }
+
+    static constexpr half_edge_t next(half_edge_t h) { return h % 3 == 2 ? h - 2 : h + 1; }
+    static constexpr half_edge_t prev(half_edge_t h) { return h % 3 == 0 ? h + 2 : h - 1; }
+
+    size_t   origin(half_edge_t h) const { return half_edges_[h].origin; }
+    size_t   apex(half_edge_t h) const { return half_edges_[prev(h)].origin; }
+    EdgeCell edge_of(half_edge_t h) const { return EdgeCell(origin(h), origin(next(h))); }
+
+    half_edge_t find_half_edge(EdgeCell const& edge) const;
+    void        relink(half_edge_t h, size_t origin, half_edge_t twin);
+
+    void insert_edge_key(EdgeCell const& edge);
+    void erase_edge_key(EdgeCell const& edge);
+    void update_flippable(half_edge_t h);
+};
+
+// include inline implementation details
+#include "mesh_triangulation_2d_half_edge.inl"
+
+#endif // CONVEX_TRIANGULATIONS_MESHTRIANGULATION2DHALFEDGE_HPP
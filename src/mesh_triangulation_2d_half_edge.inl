@@ -0,0 +1,235 @@
+#ifndef MESH_TRIANGULATION_2D_HALF_EDGE_INL
+#define MESH_TRIANGULATION_2D_HALF_EDGE_INL
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+
+inline size_t MeshTriangulation2DHalfEdge::EdgeRange::size() const
+{
+    size_t count = 0;
+    for(auto const word: mesh_->flippable_)
+        count += BitUtils::popcount(word);
+    return count;
+}
+
+
+inline MeshTriangulation2DHalfEdge::Result MeshTriangulation2DHalfEdge::triangulate()
+{
+    half_edges_.clear();
+    outgoing_.clear();
+    flippable_.clear();
+    edge_bits_.clear();
+    fingerprint_ = Fingerprint128{};
+
+    assert(geometry_);
+    size_t const n = geometry_->size();
+    if(n >= no_half_edge / 6) // a triangulation has less than 6n half-edges
+        return Result::FailedTooManyPoints;
+
+    // the sweep-hull construction is shared with the hash-map mesh, only its result is converted
+    MeshTriangulation2D<> seed(geometry_);
+    auto const            res = seed.triangulate();
+    if(res != Result::Success)
+        return res;
+
+    std::vector<TriangleCell> triangles;
+    triangles.reserve(2 * seed.edge_adjacency().size());
+    for(auto const& [edge, opposite]: seed.edge_adjacency())
+    {
+        triangles.emplace_back(edge.a, edge.b, opposite.a);
+        if(!opposite.undefined())
+            triangles.emplace_back(edge.a, edge.b, opposite.b);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+    half_edges_.reserve(3 * triangles.size());
+    for(auto const& t: triangles)
+    {
+        bool const ccw = geometry_->orientation(t.a, t.b, t.c) > 0;
+        for(size_t const v: {t.a, ccw ? t.b : t.c, ccw ? t.c : t.b})
+            half_edges_.push_back(HalfEdge{static_cast<half_edge_t>(v), no_half_edge});
+    }
+
+    // twins are the two half-edges of the same edge, adjacent once sorted by edge index
+    std::vector<std::pair<size_t, half_edge_t>> keys;
+    keys.reserve(half_edges_.size());
+    for(half_edge_t h = 0; h < half_edges_.size(); ++h)
+        keys.emplace_back(edge_of(h).index(), h);
+    std::sort(keys.begin(), keys.end());
+    for(size_t i = 1; i < keys.size(); ++i)
+    {
+        if(keys[i - 1].first != keys[i].first)
+            continue;
+        half_edges_[keys[i - 1].second].twin = keys[i].second;
+        half_edges_[keys[i].second].twin     = keys[i - 1].second;
+    }
+
+    outgoing_.assign(n, no_half_edge);
+    flippable_.assign((half_edges_.size() + 63) / 64, 0);
+    edge_bits_.assign((n * (n - 1) / 2 + 63) / 64, 0);
+    for(half_edge_t h = 0; h < half_edges_.size(); ++h)
+    {
+        half_edge_t const twin = half_edges_[h].twin;
+        outgoing_[origin(h)]   = h;
+        if(twin == no_half_edge || h < twin)
+            insert_edge_key(edge_of(h));
+        if(twin != no_half_edge && h < twin)
+            update_flippable(h);
+    }
+
+    return Result::Success;
+}
+
+
+inline MeshTriangulation2DHalfEdge::Result MeshTriangulation2DHalfEdge::flip_edge(EdgeCell const edge)
+{
+    if(!contains(edge))
+        return Result::FailedEdgeNotFound;
+
+    half_edge_t const h = find_half_edge(edge);
+    assert(h != no_half_edge);
+    half_edge_t const g = half_edges_[h].twin;
+    if(g == no_half_edge || !test(flippable_, std::min(h, g)))
+        return Result::FailedFlipBorderEdge;
+
+    // h = a->b in the triangle (a, b, c), g = b->a in the triangle (b, a, d)
+    half_edge_t const h1 = next(h);
+    half_edge_t const h2 = prev(h);
+    half_edge_t const g1 = next(g);
+    half_edge_t const g2 = prev(g);
+
+    size_t const a = origin(h);
+    size_t const b = origin(h1);
+    size_t const c = origin(h2);
+    size_t const d = origin(g2);
+
+    half_edge_t const bc = half_edges_[h1].twin;
+    half_edge_t const ca = half_edges_[h2].twin;
+    half_edge_t const ad = half_edges_[g1].twin;
+    half_edge_t const db = half_edges_[g2].twin;
+
+    // the triangles become (c, d, b) and (d, c, a), both counter-clockwise as the quadrilateral a, d, b, c is
+    relink(h, c, g);
+    relink(h1, d, db);
+    relink(h2, b, bc);
+    relink(g, d, h);
+    relink(g1, c, ca);
+    relink(g2, a, ad);
+
+    outgoing_[a] = g2;
+    outgoing_[b] = h2;
+    outgoing_[c] = h;
+    outgoing_[d] = g;
+
+    erase_edge_key(edge);
+    insert_edge_key(EdgeCell(c, d));
+
+    // the quadrilateral is unchanged by the flip, so the new diagonal is flippable back
+    reset(flippable_, std::max(h, g));
+    set(flippable_, std::min(h, g));
+    update_flippable(h1);
+    update_flippable(h2);
+    update_flippable(g1);
+    update_flippable(g2);
+
+    return Result::Success;
+}
+
+
+inline EdgeCell MeshTriangulation2DHalfEdge::opposite_edge(EdgeCell const& edge) const
+{
+    if(!contains(edge))
+        return EdgeCell();
+
+    half_edge_t const h = find_half_edge(edge);
+    if(h == no_half_edge)
+        return EdgeCell();
+
+    // like the other meshes, a border edge has the undefined vertex on its outer side
+    half_edge_t const g = half_edges_[h].twin;
+    return EdgeCell(apex(h), g == no_half_edge ? -1ull : apex(g));
+}
+
+
+inline MeshTriangulation2DHalfEdge::half_edge_t MeshTriangulation2DHalfEdge::find_half_edge(EdgeCell const& edge) const
+{
+    size_t const      a     = edge.a;
+    size_t const      b     = edge.b;
+    half_edge_t const start = outgoing_[a];
+
+    // each triangle around a has one half-edge leaving and one entering a, either can belong to the edge
+    auto const match = [&](half_edge_t const out)
+    {
+        if(origin(next(out)) == b)
+            return out;
+        return apex(out) == b ? prev(out) : no_half_edge;
+    };
+
+    // rotate clockwise, the twin of the entering half-edge leaves a in the next triangle
+    half_edge_t h = start;
+    do
+    {
+        if(half_edge_t const found = match(h); found != no_half_edge)
+            return found;
+        h = half_edges_[prev(h)].twin;
+    } while(h != no_half_edge && h != start);
+
+    if(h == start)
+        return no_half_edge;
+
+    // a is on the border, rotate counter-clockwise from start up to the other border edge
+    for(half_edge_t twin = half_edges_[start].twin; twin != no_half_edge; twin = half_edges_[h].twin)
+    {
+        h = next(twin);
+        if(half_edge_t const found = match(h); found != no_half_edge)
+            return found;
+    }
+    return no_half_edge;
+}
+
+
+inline void MeshTriangulation2DHalfEdge::relink(half_edge_t const h, size_t const origin, half_edge_t const twin)
+{
+    half_edges_[h] = HalfEdge{static_cast<half_edge_t>(origin), twin};
+    if(twin != no_half_edge)
+        half_edges_[twin].twin = h;
+}
+
+
+inline void MeshTriangulation2DHalfEdge::insert_edge_key(EdgeCell const& edge)
+{
+    size_t const idx = edge.index();
+    set(edge_bits_, idx);
+    fingerprint_ += HashUtils::unordered_element128(idx);
+}
+
+
+inline void MeshTriangulation2DHalfEdge::erase_edge_key(EdgeCell const& edge)
+{
+    size_t const idx = edge.index();
+    reset(edge_bits_, idx);
+    fingerprint_ -= HashUtils::unordered_element128(idx);
+}
+
+
+inline void MeshTriangulation2DHalfEdge::update_flippable(half_edge_t const h)
+{
+    half_edge_t const twin = half_edges_[h].twin;
+    if(twin == no_half_edge)
+    {
+        reset(flippable_, h);
+        return;
+    }
+
+    // the flag lives on the smaller half-edge of the pair, which may have changed with the last flip
+    reset(flippable_, std::max(h, twin));
+    if(geometry_->is_strictly_convex_quadrilateral(edge_of(h), EdgeCell(apex(h), apex(twin))))
+        set(flippable_, std::min(h, twin));
+    else
+        reset(flippable_, std::min(h, twin));
+}
+
+#endif // MESH_TRIANGULATION_2D_HALF_EDGE_INL
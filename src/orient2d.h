@@ -0,0 +1,40 @@
+#ifndef CONVEX_TRIANGULATIONS_ORIENT2D_HPP
+#define CONVEX_TRIANGULATIONS_ORIENT2D_HPP
+
+#include "mesh_cell.h"
+#include "vec2.h"
+
+#include <vector>
+
+
+// Orientation predicates shared by the mesh backends.
+//
+// Integral point sets (e.g. the lattices of the README) are decided exactly in 64-bit integer arithmetic, which is
+// both cheaper than the floating point path and free of epsilon misclassifications for nearly degenerate triples.
+// Other point sets keep the epsilon tests of the original mesh: a cross product within epsilon of zero is collinear,
+// and a quadrilateral is convex if both diagonals split it into the same area up to epsilon (Heron's formula).
+
+// coordinates up to this magnitude keep every integer cross product within 63 bits
+inline constexpr Vec2::float_type max_exact_coordinate = 1 << 29;
+
+// whether all coordinates are integers of magnitude at most max_exact_coordinate
+bool has_integral_coordinates(std::vector<Vec2> const& coords);
+
+// sign of the cross product (p2 - p1) x (p3 - p1): 1 for a counter-clockwise triple, -1 clockwise, 0 collinear
+int orient2d_exact(Vec2 const& p1, Vec2 const& p2, Vec2 const& p3);
+int orient2d_inexact(Vec2 const& p1, Vec2 const& p2, Vec2 const& p3);
+
+inline int orient2d(Vec2 const& p1, Vec2 const& p2, Vec2 const& p3, bool const exact)
+{
+    return exact ? orient2d_exact(p1, p2, p3) : orient2d_inexact(p1, p2, p3);
+}
+
+// whether the quadrilateral (edge.a, opposite.a, edge.b, opposite.b) around edge is strictly convex, i.e. both
+// diagonals separate the other two vertices strictly
+bool is_strictly_convex_quadrilateral(std::vector<Vec2> const& coords, EdgeCell const& edge, EdgeCell const& opposite,
+                                      bool exact);
+
+
+#include "orient2d.inl"
+
+#endif // CONVEX_TRIANGULATIONS_ORIENT2D_HPP
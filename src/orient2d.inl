@@ -0,0 +1,87 @@
+#ifndef ORIENT2D_INL
+#define ORIENT2D_INL
+
+#include "utils/float.h"
+
+#include <cmath>
+#include <cstdint>
+
+
+inline bool has_integral_coordinates(std::vector<Vec2> const& coords)
+{
+    auto const is_exact = [](Vec2::float_type const v)
+    { return std::abs(v) <= max_exact_coordinate && std::floor(v) == v; };
+
+    for(auto const& p: coords)
+    {
+        if(!is_exact(p.x) || !is_exact(p.y))
+            return false;
+    }
+    return true;
+}
+
+
+inline int orient2d_exact(Vec2 const& p1, Vec2 const& p2, Vec2 const& p3)
+{
+    int64_t const x1 = static_cast<int64_t>(p1.x);
+    int64_t const y1 = static_cast<int64_t>(p1.y);
+
+    int64_t const cross = (static_cast<int64_t>(p2.x) - x1) * (static_cast<int64_t>(p3.y) - y1) -
+                          (static_cast<int64_t>(p2.y) - y1) * (static_cast<int64_t>(p3.x) - x1);
+    return (cross > 0) - (cross < 0);
+}
+
+
+inline int orient2d_inexact(Vec2 const& p1, Vec2 const& p2, Vec2 const& p3)
+{
+    Vec2::float_type const cross = Vec2::cross(p1, p2, p3);
+    if(detail::is_same_epsilon(cross, 0))
+        return 0;
+    return cross > 0 ? 1 : -1;
+}
+
+
+namespace detail
+{
+    // area of the triangle p1, p2, p3 from its side lengths (Heron's formula, up to a constant factor), as the
+    // flippability test of the original mesh computed it
+    inline Vec2::float_type heron_area(Vec2 const& p1, Vec2 const& p2, Vec2 const& p3)
+    {
+        using float_type = Vec2::float_type;
+
+        float_type const ab_norm2      = (p1 - p2).norm2();
+        float_type const ac_norm2      = (p1 - p3).norm2();
+        float_type const bc_norm2      = (p2 - p3).norm2();
+        float_type const ac2_minus_bc2 = ac_norm2 - bc_norm2;
+
+        float_type const area2 =
+            0.5 * (-ab_norm2 * ab_norm2 - ac2_minus_bc2 * ac2_minus_bc2 + 2.0 * ab_norm2 * (ac_norm2 + bc_norm2));
+        return std::sqrt(area2);
+    }
+} // namespace detail
+
+
+inline bool is_strictly_convex_quadrilateral(std::vector<Vec2> const& coords, EdgeCell const& edge,
+                                             EdgeCell const& opposite, bool const exact)
+{
+    Vec2 const& a = coords[edge.a];
+    Vec2 const& b = coords[edge.b];
+    Vec2 const& c = coords[opposite.a];
+    Vec2 const& d = coords[opposite.b];
+
+    // both products are -1 iff the pairs lie strictly on different sides, a zero sign means a degenerate quadrilateral
+    if(exact)
+        return orient2d_exact(a, b, c) * orient2d_exact(a, b, d) < 0 &&
+               orient2d_exact(c, d, a) * orient2d_exact(c, d, b) < 0;
+
+    // floating point coordinates keep the tolerance of the original test: both diagonals split the quadrilateral into
+    // the same area, up to an epsilon, and none of the four triangles is degenerate
+    Vec2::float_type const t1   = detail::heron_area(a, b, c);
+    Vec2::float_type const t2   = detail::heron_area(a, b, d);
+    Vec2::float_type const t1_f = detail::heron_area(c, d, a);
+    Vec2::float_type const t2_f = detail::heron_area(c, d, b);
+    return detail::is_same_epsilon(t1 + t2, t1_f + t2_f) && !detail::is_same_epsilon(t1, 0) &&
+           !detail::is_same_epsilon(t2, 0) && !detail::is_same_epsilon(t1_f, 0) && !detail::is_same_epsilon(t2_f, 0);
+}
+
+#endif // ORIENT2D_INL
@@ -0,0 +1,57 @@
+#ifndef CONVEX_TRIANGULATIONS_POINTSETCROSSINGS_HPP
+#define CONVEX_TRIANGULATIONS_POINTSETCROSSINGS_HPP
+
+#include "mesh_cell.h"
+#include "point_set_geometry.h"
+#include "utils/bits.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+// Crossing relation between the n(n-1)/2 candidate edges of a point set (see EdgeCell::index), as a bit-packed matrix:
+// row e has the bit of every candidate edge crossing e in both relative interiors. Intersecting a row with the edge
+// bitset of a mesh (canonical_key()) counts the edges of the triangulation crossing e with a few popcounts.
+//
+// The table takes O(n^4) time and n^4/16 bytes to build, so unlike PointSetGeometry it is not part of every mesh:
+// construct it once per point set where crossing queries are needed (see triangulation_crossings.h). Point sets above
+// max_table_points are not tabulated, their queries are evaluated on the fly instead.
+class PointSetCrossings
+{
+public:
+    static constexpr size_t max_table_points = 64;
+
+    explicit PointSetCrossings(std::shared_ptr<PointSetGeometry const> geometry);
+
+    std::shared_ptr<PointSetGeometry const> const& geometry() const { return geometry_; }
+
+    bool has_table() const { return !crossings_.empty(); }
+
+    // whether the segments cross in their relative interiors, edges sharing an endpoint never cross
+    bool crosses(EdgeCell const& lhs, EdgeCell const& rhs) const;
+
+    // whether no other point lies in the relative interior of edge; only admissible edges occur in triangulations
+    bool admissible(EdgeCell const& edge) const;
+
+    // crossing row of edge, row_words() words long; the table must exist
+    uint64_t const* row(EdgeCell const& edge) const;
+    size_t          row_words() const { return row_words_; }
+
+    // number of edges of the edge bitset (num_words words, indexed by EdgeCell::index) crossing edge
+    size_t count_crossings(EdgeCell const& edge, uint64_t const* edge_bits, size_t num_words) const;
+
+private:
+    std::shared_ptr<PointSetGeometry const> geometry_;
+    size_t                                  row_words_ = 0;
+    std::vector<uint64_t>                   crossings_;  // row e starts at e * row_words_, empty if not tabulated
+    std::vector<uint64_t>                   admissible_; // one bit per candidate edge, tabulated with crossings_
+
+    bool is_admissible(EdgeCell const& edge) const;
+};
+
+
+#include "point_set_crossings.inl"
+
+#endif // CONVEX_TRIANGULATIONS_POINTSETCROSSINGS_HPP
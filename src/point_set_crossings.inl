@@ -0,0 +1,113 @@
+#ifndef POINT_SET_CROSSINGS_INL
+#define POINT_SET_CROSSINGS_INL
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+
+inline PointSetCrossings::PointSetCrossings(std::shared_ptr<PointSetGeometry const> geometry)
+    : geometry_(std::move(geometry))
+{
+    assert(geometry_);
+    size_t const n = geometry_->size();
+    if(n < 2 || n > max_table_points)
+        return;
+
+    row_words_ = (geometry_->num_edges() + 63) / 64;
+    crossings_.assign(geometry_->num_edges() * row_words_, 0);
+    admissible_.assign(row_words_, 0);
+
+    // the relation is symmetric, test each unordered pair of candidate edges once and set both bits
+    for(size_t b = 1; b < n; ++b)
+    {
+        for(size_t a = 0; a < b; ++a)
+        {
+            EdgeCell const lhs(a, b);
+            size_t const   lhs_idx = lhs.index();
+            if(is_admissible(lhs))
+                admissible_[lhs_idx / 64] |= uint64_t{1} << (lhs_idx % 64);
+
+            for(size_t d = b; d < n; ++d)
+            {
+                for(size_t c = (d == b ? a + 1 : 0); c < d; ++c)
+                {
+                    EdgeCell const rhs(c, d);
+                    if(!crosses(lhs, rhs))
+                        continue;
+
+                    size_t const rhs_idx = rhs.index();
+                    crossings_[lhs_idx * row_words_ + rhs_idx / 64] |= uint64_t{1} << (rhs_idx % 64);
+                    crossings_[rhs_idx * row_words_ + lhs_idx / 64] |= uint64_t{1} << (lhs_idx % 64);
+                }
+            }
+        }
+    }
+}
+
+
+inline bool PointSetCrossings::crosses(EdgeCell const& lhs, EdgeCell const& rhs) const
+{
+    if(lhs.a == rhs.a || lhs.a == rhs.b || lhs.b == rhs.a || lhs.b == rhs.b)
+        return false;
+    return geometry_->is_strictly_convex_quadrilateral(lhs, rhs);
+}
+
+
+inline bool PointSetCrossings::admissible(EdgeCell const& edge) const
+{
+    if(admissible_.empty())
+        return is_admissible(edge);
+
+    size_t const idx = edge.index();
+    return (admissible_[idx / 64] >> (idx % 64)) & 1u;
+}
+
+
+inline bool PointSetCrossings::is_admissible(EdgeCell const& edge) const
+{
+    auto const& pts = geometry_->coords();
+    Vec2 const& a   = pts[edge.a];
+    Vec2 const& b   = pts[edge.b];
+    for(size_t v = 0; v < geometry_->size(); ++v)
+    {
+        if(v == edge.a || v == edge.b || geometry_->orientation(edge.a, edge.b, v) != 0)
+            continue;
+
+        // collinear, inside the bounding box of the edge means inside the edge
+        Vec2 const& p = pts[v];
+        if(std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) && std::min(a.y, b.y) <= p.y &&
+           p.y <= std::max(a.y, b.y))
+            return false;
+    }
+    return true;
+}
+
+
+inline uint64_t const* PointSetCrossings::row(EdgeCell const& edge) const
+{
+    assert(has_table());
+    return crossings_.data() + edge.index() * row_words_;
+}
+
+
+inline size_t PointSetCrossings::count_crossings(EdgeCell const& edge, uint64_t const* edge_bits,
+                                                 size_t const num_words) const
+{
+    if(has_table())
+        return BitUtils::popcount_and(row(edge), edge_bits, std::min(num_words, row_words_));
+
+    size_t count = 0;
+    for(size_t b = 1; b < geometry_->size(); ++b)
+    {
+        for(size_t a = 0; a < b; ++a)
+        {
+            size_t const idx = EdgeCell(a, b).index();
+            if(idx / 64 < num_words && ((edge_bits[idx / 64] >> (idx % 64)) & 1u) && crosses(edge, EdgeCell(a, b)))
+                ++count;
+        }
+    }
+    return count;
+}
+
+#endif // POINT_SET_CROSSINGS_INL
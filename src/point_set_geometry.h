@@ -0,0 +1,54 @@
+#ifndef CONVEX_TRIANGULATIONS_POINTSETGEOMETRY_HPP
+#define CONVEX_TRIANGULATIONS_POINTSETGEOMETRY_HPP
+
+#include "mesh_cell.h"
+#include "orient2d.h"
+#include "vec2.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+// Geometry of a point set that does not depend on the triangulation. Built once from the coordinates and shared
+// read-only by every mesh over the same point set (mesh copies only copy the pointer), it tabulates the orientation
+// of all n^3 ordered triples, so that the flippability test of an edge becomes four table lookups (for integral point
+// sets, the inexact test compares triangle areas, see is_strictly_convex_quadrilateral()).
+//
+// Point sets above max_table_points are not tabulated (the table grows cubically), their predicates are evaluated
+// on the fly instead. The crossing relation between candidate edges is tabulated separately by PointSetCrossings.
+class PointSetGeometry
+{
+public:
+    static constexpr size_t max_table_points = 128;
+
+    explicit PointSetGeometry(std::shared_ptr<std::vector<Vec2> const> coords);
+
+    std::vector<Vec2> const&                        coords() const { return *coords_ptr_; }
+    std::shared_ptr<std::vector<Vec2> const> const& coords_ptr() const { return coords_ptr_; }
+    size_t                                          size() const { return num_points_; }
+
+    // whether the predicates are exact, see has_integral_coordinates()
+    bool exact() const { return exact_; }
+
+    // orient2d() of the points a, b, c
+    int orientation(size_t a, size_t b, size_t c) const;
+
+    // is_strictly_convex_quadrilateral() of the points
+    bool is_strictly_convex_quadrilateral(EdgeCell const& edge, EdgeCell const& opposite) const;
+
+    // number of candidate edges, see EdgeCell::index
+    size_t num_edges() const { return num_points_ * (num_points_ - 1) / 2; }
+
+private:
+    std::shared_ptr<std::vector<Vec2> const> coords_ptr_;
+    size_t                                   num_points_;
+    bool                                     exact_;
+    std::vector<int8_t>                      orientation_; // indexed by (a * n + b) * n + c, empty if not tabulated
+};
+
+
+#include "point_set_geometry.inl"
+
+#endif // CONVEX_TRIANGULATIONS_POINTSETGEOMETRY_HPP
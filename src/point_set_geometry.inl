@@ -0,0 +1,49 @@
+#ifndef POINT_SET_GEOMETRY_INL
+#define POINT_SET_GEOMETRY_INL
+
+#include <cassert>
+#include <utility>
+
+
+inline PointSetGeometry::PointSetGeometry(std::shared_ptr<std::vector<Vec2> const> coords)
+    : coords_ptr_(std::move(coords)),
+      num_points_(coords_ptr_ ? coords_ptr_->size() : 0),
+      exact_(coords_ptr_ && has_integral_coordinates(*coords_ptr_))
+{
+    if(num_points_ > max_table_points)
+        return;
+
+    auto const&  pts = *coords_ptr_;
+    size_t const n   = num_points_;
+    orientation_.resize(n * n * n);
+    for(size_t a = 0; a < n; ++a)
+    {
+        for(size_t b = 0; b < n; ++b)
+        {
+            for(size_t c = 0; c < n; ++c)
+                orientation_[(a * n + b) * n + c] = static_cast<int8_t>(orient2d(pts[a], pts[b], pts[c], exact_));
+        }
+    }
+}
+
+
+inline int PointSetGeometry::orientation(size_t const a, size_t const b, size_t const c) const
+{
+    assert(a < num_points_ && b < num_points_ && c < num_points_);
+    if(orientation_.empty())
+        return orient2d(coords()[a], coords()[b], coords()[c], exact_);
+    return orientation_[(a * num_points_ + b) * num_points_ + c];
+}
+
+
+inline bool PointSetGeometry::is_strictly_convex_quadrilateral(EdgeCell const& edge, EdgeCell const& opposite) const
+{
+    // the inexact test compares areas instead of orientations, the table only serves the exact one
+    if(orientation_.empty() || !exact_)
+        return ::is_strictly_convex_quadrilateral(coords(), edge, opposite, exact_);
+
+    return orientation(edge.a, edge.b, opposite.a) * orientation(edge.a, edge.b, opposite.b) < 0 &&
+           orientation(opposite.a, opposite.b, edge.a) * orientation(opposite.a, opposite.b, edge.b) < 0;
+}
+
+#endif // POINT_SET_GEOMETRY_INL
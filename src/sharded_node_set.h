@@ -0,0 +1,115 @@
+#ifndef CONVEX_TRIANGULATIONS_SHARDEDNODESET_HPP
+#define CONVEX_TRIANGULATIONS_SHARDEDNODESET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+
+// Concurrent set of mesh pointers, keyed by the mesh fingerprint. The high fingerprint bits select one of num_shards
+// independently locked shards, each an open-addressing table with linear probing whose slots store the low fingerprint
+// word inline next to the pointer: a probe usually touches a single cache line and only dereferences a mesh (through
+// KeyEqual) when the inline fingerprints already match.
+//
+// find(), insert() and size() are safe to call concurrently. The iterators they return carry the pointer they refer to,
+// so dereferencing them stays valid while other threads grow the shard; walking the set from begin() to end() is only
+// valid once no thread is inserting anymore.
+template<class Mesh, class KeyEqual>
+class ShardedNodeSet
+{
+    struct Slot
+    {
+        uint64_t    fingerprint = 0;
+        Mesh const* node        = nullptr;
+    };
+
+    struct alignas(64) Shard
+    {
+        std::mutex        mutex;
+        std::vector<Slot> slots;
+        size_t            size = 0;
+    };
+
+public:
+    using value_type = Mesh const*;
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Mesh const*;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Mesh const* const*;
+        using reference         = Mesh const* const&;
+
+        iterator() = default;
+        iterator(ShardedNodeSet const* set, size_t shard, size_t slot, Mesh const* node)
+            : set_(set),
+              shard_(shard),
+              slot_(slot),
+              node_(node)
+        {}
+
+        reference operator*() const { return node_; }
+        iterator& operator++()
+        {
+            *this = set_->next(shard_, slot_ + 1);
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(iterator const& rhs) const { return shard_ == rhs.shard_ && slot_ == rhs.slot_; }
+        bool operator!=(iterator const& rhs) const { return !(*this == rhs); }
+
+    private:
+        ShardedNodeSet const* set_   = nullptr;
+        size_t                shard_ = 0;
+        size_t                slot_  = 0;
+        Mesh const*           node_  = nullptr;
+    };
+
+    explicit ShardedNodeSet(size_t num_shards = 256);
+
+    iterator                  find(Mesh const* key) const;
+    std::pair<iterator, bool> insert(Mesh const* key);
+    std::pair<iterator, bool> emplace(Mesh const* key) { return insert(key); }
+
+    // clear() keeps the shard tables, reserve() is a hint: shards are pre-sized for at most max_reserved_capacity
+    // slots, since the flip graph engines pass generous upper bounds and open addressing, unlike a bucket list, would
+    // allocate and clear the whole table eagerly
+    void   clear();
+    void   reserve(size_t count);
+    size_t size() const;
+    bool   empty() const { return size() == 0; }
+
+    iterator begin() const { return next(0, 0); }
+    iterator end() const { return iterator(this, num_shards_, 0, nullptr); }
+
+private:
+    size_t                   num_shards_;
+    size_t                   shard_shift_;
+    std::unique_ptr<Shard[]> shards_;
+    KeyEqual                 equal_;
+
+    static constexpr size_t min_shard_capacity    = 16;
+    static constexpr size_t max_reserved_capacity = 1024;
+
+    // slot of key in the shard, or of the empty slot where it would be inserted; the shard lock must be held
+    size_t   probe(Shard const& shard, Mesh const* key) const;
+    void     grow(Shard& shard, size_t capacity);
+    iterator next(size_t shard, size_t slot) const;
+};
+
+
+#include "sharded_node_set.inl"
+
+#endif // CONVEX_TRIANGULATIONS_SHARDEDNODESET_HPP
@@ -0,0 +1,165 @@
+#ifndef SHARDED_NODE_SET_INL
+#define SHARDED_NODE_SET_INL
+
+#include <algorithm>
+
+
+namespace detail
+{
+    constexpr size_t next_power_of_two(size_t x)
+    {
+        size_t p = 1;
+        while(p < x)
+            p <<= 1;
+        return p;
+    }
+
+    constexpr size_t log2_power_of_two(size_t x)
+    {
+        size_t l = 0;
+        while(x >>= 1)
+            ++l;
+        return l;
+    }
+} // namespace detail
+
+
+template<class Mesh, class KeyEqual>
+ShardedNodeSet<Mesh, KeyEqual>::ShardedNodeSet(size_t const num_shards)
+    : num_shards_(detail::next_power_of_two(num_shards > 1 ? num_shards : 2)),
+      shard_shift_(64 - detail::log2_power_of_two(num_shards_)),
+      shards_(std::make_unique<Shard[]>(num_shards_))
+{}
+
+
+template<class Mesh, class KeyEqual>
+size_t ShardedNodeSet<Mesh, KeyEqual>::probe(Shard const& shard, Mesh const* key) const
+{
+    uint64_t const fingerprint = key->fingerprint().lo;
+    size_t const   mask        = shard.slots.size() - 1;
+    for(size_t idx = fingerprint & mask;; idx = (idx + 1) & mask)
+    {
+        Slot const& slot = shard.slots[idx];
+        if(slot.node == nullptr || (slot.fingerprint == fingerprint && equal_(slot.node, key)))
+            return idx;
+    }
+}
+
+
+template<class Mesh, class KeyEqual>
+void ShardedNodeSet<Mesh, KeyEqual>::grow(Shard& shard, size_t const capacity)
+{
+    std::vector<Slot> old_slots(capacity);
+    old_slots.swap(shard.slots);
+
+    size_t const mask = shard.slots.size() - 1;
+    for(auto const& slot: old_slots)
+    {
+        if(slot.node == nullptr)
+            continue;
+        size_t idx = slot.fingerprint & mask;
+        while(shard.slots[idx].node != nullptr)
+            idx = (idx + 1) & mask;
+        shard.slots[idx] = slot;
+    }
+}
+
+
+template<class Mesh, class KeyEqual>
+typename ShardedNodeSet<Mesh, KeyEqual>::iterator ShardedNodeSet<Mesh, KeyEqual>::find(Mesh const* key) const
+{
+    size_t const shard_idx = key->fingerprint().hi >> shard_shift_;
+    Shard&       shard     = shards_[shard_idx];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if(shard.slots.empty())
+        return end();
+
+    size_t const idx = probe(shard, key);
+    if(shard.slots[idx].node == nullptr)
+        return end();
+    return iterator(this, shard_idx, idx, shard.slots[idx].node);
+}
+
+
+template<class Mesh, class KeyEqual>
+std::pair<typename ShardedNodeSet<Mesh, KeyEqual>::iterator, bool>
+ShardedNodeSet<Mesh, KeyEqual>::insert(Mesh const* key)
+{
+    size_t const shard_idx = key->fingerprint().hi >> shard_shift_;
+    Shard&       shard     = shards_[shard_idx];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // keep the load factor below 0.7, probes then stay short with linear probing
+    if(10 * (shard.size + 1) > 7 * shard.slots.size())
+        grow(shard, std::max(min_shard_capacity, 2 * shard.slots.size()));
+
+    size_t const idx  = probe(shard, key);
+    Slot&        slot = shard.slots[idx];
+    if(slot.node != nullptr)
+        return {iterator(this, shard_idx, idx, slot.node), false};
+
+    slot.fingerprint = key->fingerprint().lo;
+    slot.node        = key;
+    ++shard.size;
+    return {iterator(this, shard_idx, idx, key), true};
+}
+
+
+template<class Mesh, class KeyEqual>
+void ShardedNodeSet<Mesh, KeyEqual>::clear()
+{
+    for(size_t s = 0; s < num_shards_; ++s)
+    {
+        std::lock_guard<std::mutex> lock(shards_[s].mutex);
+        std::fill(shards_[s].slots.begin(), shards_[s].slots.end(), Slot{});
+        shards_[s].size = 0;
+    }
+}
+
+
+template<class Mesh, class KeyEqual>
+void ShardedNodeSet<Mesh, KeyEqual>::reserve(size_t const count)
+{
+    size_t const per_shard = (count + num_shards_ - 1) / num_shards_;
+    size_t const capacity  = std::min(max_reserved_capacity,
+                                      detail::next_power_of_two(std::max(min_shard_capacity, 10 * per_shard / 7 + 1)));
+    for(size_t s = 0; s < num_shards_; ++s)
+    {
+        std::lock_guard<std::mutex> lock(shards_[s].mutex);
+        if(shards_[s].slots.size() < capacity)
+            grow(shards_[s], capacity);
+    }
+}
+
+
+template<class Mesh, class KeyEqual>
+size_t ShardedNodeSet<Mesh, KeyEqual>::size() const
+{
+    size_t count = 0;
+    for(size_t s = 0; s < num_shards_; ++s)
+    {
+        std::lock_guard<std::mutex> lock(shards_[s].mutex);
+        count += shards_[s].size;
+    }
+    return count;
+}
+
+
+template<class Mesh, class KeyEqual>
+typename ShardedNodeSet<Mesh, KeyEqual>::iterator ShardedNodeSet<Mesh, KeyEqual>::next(size_t shard,
+                                                                                          size_t slot) const
+{
+    for(; shard < num_shards_; ++shard, slot = 0)
+    {
+        auto const& slots = shards_[shard].slots;
+        for(; slot < slots.size(); ++slot)
+        {
+            if(slots[slot].node != nullptr)
+                return iterator(this, shard, slot, slots[slot].node);
+        }
+    }
+    return end();
+}
+
+#endif // SHARDED_NODE_SET_INL
@@ -0,0 +1,34 @@
+#ifndef CONVEX_TRIANGULATIONS_TRIANGULATIONCROSSINGS_HPP
+#define CONVEX_TRIANGULATIONS_TRIANGULATIONCROSSINGS_HPP
+
+#include "mesh_cell.h"
+#include "mesh_triangulation_2d_bitset.h"
+#include "point_set_crossings.h"
+
+#include <cstddef>
+
+
+// Crossing queries between triangulations of the same point set, on top of any mesh exposing the candidate edge bitset
+// canonical_key(). The crossings argument is the PointSetCrossings of that point set, built once by the caller; with
+// its table the queries reduce to popcounts. Edge indices are decoded like MeshTriangulation2DBitset, so the point set
+// may have at most max_crossing_query_points points.
+
+inline constexpr size_t max_crossing_query_points = MeshTriangulation2DBitset<256>::max_points;
+
+// number of pairs (e, f) of an edge e of lhs and an edge f of rhs that cross
+template<class Mesh>
+size_t count_crossing_pairs(PointSetCrossings const& crossings, Mesh const& lhs, Mesh const& rhs);
+
+// every flip replaces a single edge, so at least |lhs \ rhs| flips separate the two triangulations
+template<class Mesh>
+size_t flip_distance_lower_bound(Mesh const& lhs, Mesh const& rhs);
+
+// whether flipping edge of mesh inserts diagonal, i.e. diagonal crosses edge and no other edge of mesh; unlike
+// opposite_edge() this does not need the adjacency of edge
+template<class Mesh>
+bool is_flip_of(PointSetCrossings const& crossings, Mesh const& mesh, EdgeCell const& edge, EdgeCell const& diagonal);
+
+
+#include "triangulation_crossings.inl"
+
+#endif // CONVEX_TRIANGULATIONS_TRIANGULATIONCROSSINGS_HPP
@@ -0,0 +1,64 @@
+#ifndef TRIANGULATION_CROSSINGS_INL
+#define TRIANGULATION_CROSSINGS_INL
+
+#include "utils/bits.h"
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace detail
+{
+    // call f with the EdgeCell::index of every edge of the candidate edge bitset
+    template<class Key, class F>
+    void for_each_edge_index(Key const& key, F&& f)
+    {
+        for(size_t w = 0; w < key.size(); ++w)
+        {
+            for(uint64_t word = key[w]; word != 0; word &= word - 1)
+                f(w * 64 + BitUtils::countr_zero(word));
+        }
+    }
+} // namespace detail
+
+
+template<class Mesh>
+size_t count_crossing_pairs(PointSetCrossings const& crossings, Mesh const& lhs, Mesh const& rhs)
+{
+    using Decoder_t = MeshTriangulation2DBitset<max_crossing_query_points>;
+    assert(crossings.geometry()->size() <= max_crossing_query_points);
+    auto const& rhs_key = rhs.canonical_key();
+
+    size_t count = 0;
+    detail::for_each_edge_index(lhs.canonical_key(), [&](size_t const idx)
+                                { count += crossings.count_crossings(Decoder_t::edge_from_index(idx), rhs_key.data(),
+                                                                     rhs_key.size()); });
+    return count;
+}
+
+
+template<class Mesh>
+size_t flip_distance_lower_bound(Mesh const& lhs, Mesh const& rhs)
+{
+    auto const& lhs_key = lhs.canonical_key();
+    auto const& rhs_key = rhs.canonical_key();
+    return BitUtils::popcount_and_not(lhs_key.data(), rhs_key.data(), std::min(lhs_key.size(), rhs_key.size()));
+}
+
+
+template<class Mesh>
+bool is_flip_of(PointSetCrossings const& crossings, Mesh const& mesh, EdgeCell const& edge, EdgeCell const& diagonal)
+{
+    auto const& key = mesh.canonical_key();
+
+    size_t const idx = edge.index();
+    if(idx / 64 >= key.size() || ((key[idx / 64] >> (idx % 64)) & 1u) == 0)
+        return false;
+
+    // diagonal cannot be in mesh once it crosses edge, which then is the only mesh edge it may cross; a diagonal
+    // through another point could cross edge alone too, passing that point along mesh edges
+    return crossings.crosses(edge, diagonal) && crossings.admissible(diagonal) &&
+           crossings.count_crossings(diagonal, key.data(), key.size()) == 1;
+}
+
+#endif // TRIANGULATION_CROSSINGS_INL
@@ -1,99 +1,395 @@
 #ifndef CONVEX_TRIANGULATIONS_TRIANGULATIONFLIPGRAPH_HPP
 #define CONVEX_TRIANGULATIONS_TRIANGULATIONFLIPGRAPH_HPP
 
+#include "delaunay.h"
+#include "flip_graph_csr.h"
 #include "mesh_triangulation_2d.h"
+#include "point_set_geometry.h"
+#include "sharded_node_set.h"
+#include "utils/arena.h"
 #include "utils/hash.h"
+#include "utils/scoped_flip.h"
+#include "utils/work_queue.h"
 #include "vec2.h"
 
 #include <cstddef>
 
+#include <atomic>
+#include <memory>
 #include <moodycamel/concurrent_queue.h>
+#include <queue>
 #include <tbb/concurrent_unordered_set.h>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
 
+// Node equality compares the 128-bit fingerprints first and only falls back to the full mesh comparison when they
+// match. TRIANGULATION_FLIP_GRAPH_TRUST_FINGERPRINT skips the full comparison altogether, while
+// TRIANGULATION_FLIP_GRAPH_DEBUG_FINGERPRINT keeps it and counts the fingerprint false positives.
+#ifndef TRIANGULATION_FLIP_GRAPH_TRUST_FINGERPRINT
+#define TRIANGULATION_FLIP_GRAPH_TRUST_FINGERPRINT 0
+#endif
+
+#ifndef TRIANGULATION_FLIP_GRAPH_DEBUG_FINGERPRINT
+#define TRIANGULATION_FLIP_GRAPH_DEBUG_FINGERPRINT 0
+#endif
+
+
+// Nodes are either owned by the set (std::unique_ptr) or owned elsewhere and referenced by pointer.
 struct MeshTriangulation2DCRefHash
 {
-    template<class MeshTraits>
-    constexpr size_t operator()(std::unique_ptr<MeshTriangulation2D<MeshTraits> const> const& trig) const noexcept
+    template<class Mesh>
+    size_t operator()(Mesh const* trig) const noexcept
+    {
+        return trig->fingerprint().lo;
+    }
+
+    template<class Mesh>
+    size_t operator()(std::unique_ptr<Mesh const> const& trig) const noexcept
     {
-        return HashUtils::combine_unordered_range(trig->flippable().begin(), trig->flippable().end(), EdgeCellHash{});
+        return (*this)(trig.get());
     }
 };
 
 struct MeshTriangulation2DCRefEqualTo
 {
-    template<class MeshTraits>
-    constexpr size_t operator()(std::unique_ptr<MeshTriangulation2D<MeshTraits> const> const& lhs,
-                                std::unique_ptr<MeshTriangulation2D<MeshTraits> const> const& rhs) const noexcept
+    template<class Mesh>
+    bool operator()(Mesh const* lhs, Mesh const* rhs) const noexcept
     {
-        return lhs->flippable() == rhs->flippable();
+        if(lhs->fingerprint() != rhs->fingerprint())
+            return false;
+#if TRIANGULATION_FLIP_GRAPH_DEBUG_FINGERPRINT
+        bool const same = *lhs == *rhs;
+        if(!same)
+            false_positives_.fetch_add(1, std::memory_order_relaxed);
+        return same;
+#elif TRIANGULATION_FLIP_GRAPH_TRUST_FINGERPRINT
+        return true;
+#else
+        return *lhs == *rhs;
+#endif
     }
+
+    template<class Mesh>
+    bool operator()(std::unique_ptr<Mesh const> const& lhs, std::unique_ptr<Mesh const> const& rhs) const noexcept
+    {
+        return (*this)(lhs.get(), rhs.get());
+    }
+
+    // number of equal fingerprints with different meshes, only counted with TRIANGULATION_FLIP_GRAPH_DEBUG_FINGERPRINT
+    static size_t false_positives() { return false_positives_.load(std::memory_order_relaxed); }
+
+private:
+    static inline std::atomic<size_t> false_positives_{0};
 };
 
 struct MeshTriangulation2DCRefEdgeHash
 {
-    template<class MeshTraits>
-    constexpr size_t
-    operator()(std::pair<MeshTriangulation2D<MeshTraits> const*, MeshTriangulation2D<MeshTraits> const*> const& p)
-        const noexcept
+    template<class Mesh>
+    constexpr size_t operator()(std::pair<Mesh const*, Mesh const*> const& p) const noexcept
     {
-        return HashUtils::combine_unordered_pair(p, std::hash<MeshTriangulation2D<MeshTraits> const*>{});
+        return HashUtils::combine_unordered_pair(p, std::hash<Mesh const*>{});
     }
 };
 
+// flip edges are undirected, (a, b) and (b, a) are the same edge
+struct MeshTriangulation2DCRefEdgeEqualTo
+{
+    template<class Mesh>
+    constexpr bool operator()(std::pair<Mesh const*, Mesh const*> const& lhs,
+                              std::pair<Mesh const*, Mesh const*> const& rhs) const noexcept
+    {
+        return (lhs.first == rhs.first && lhs.second == rhs.second) ||
+               (lhs.first == rhs.second && lhs.second == rhs.first);
+    }
+};
 
-template<class MeshTraits>
-class TriangulationFlipGraph
+
+// How the engines record flip edges. Deduplicated inserts every flip into the shared edges() set, which removes the
+// second copy of each undirected edge. CanonicalOwner only records a flip from the endpoint with the smaller
+// fingerprint, into a per-worker buffer (edge_buffers()), so that every edge is written exactly once and the shared
+// edge set is never touched.
+enum class FlipGraphEdgeMode
+{
+    Deduplicated,
+    CanonicalOwner
+};
+
+// Triangulation the exploration starts from. SweepHull is whatever triangulate() builds, which depends on the pivot of
+// the sweep; Delaunay flips it on to the (perturbed, hence unique) Delaunay triangulation with Lawson flips, a
+// canonical root that is the same for every mesh type and run, at the cost of the flips at startup.
+enum class FlipGraphSeed
+{
+    SweepHull,
+    Delaunay
+};
+
+
+// Graph recorded by the engines below: the node set, the flip edges recorded according to FlipGraphEdgeMode and the
+// parameters of the exploration. The engines only add their storage and generate_graph(). The PointSetGeometry is
+// built once per engine and outlives every mesh it is shared with, see MeshTriangulation2DFixed.
+template<class Mesh, class NodeSet, class EdgeSet>
+class BasicTriangulationFlipGraph
 {
-    using Mesh_t = MeshTriangulation2D<MeshTraits>;
-    using NodeSet_t =
-        std::unordered_set<std::unique_ptr<Mesh_t const>, MeshTriangulation2DCRefHash, MeshTriangulation2DCRefEqualTo>;
-    using TrigEdgeSet_t = std::unordered_set<std::pair<Mesh_t const*, Mesh_t const*>, MeshTriangulation2DCRefEdgeHash>;
+protected:
+    using Mesh_t        = Mesh;
+    using NodeSet_t     = NodeSet;
+    using TrigEdgeSet_t = EdgeSet;
+    using EdgeBuffer_t  = std::vector<std::pair<Mesh_t const*, Mesh_t const*>>;
 
 public:
-    explicit TriangulationFlipGraph(std::shared_ptr<std::vector<Vec2> const> pts)
-        : coords_ptr_(std::move(pts))
-    {}
+    NodeSet_t const&                 nodes() const { return nodes_; }
+    TrigEdgeSet_t const&             edges() const { return edges_; }
+    std::vector<EdgeBuffer_t> const& edge_buffers() const { return edge_buffers_; }
 
-    void generate_graph();
+    // number of undirected edges, whichever FlipGraphEdgeMode recorded them
+    size_t num_edges() const;
 
-    NodeSet_t const&     nodes() const { return nodes_; }
-    TrigEdgeSet_t const& edges() const { return edges_; }
+    // convert the generated graph into CSR form and free the recorded edges, edges() and edge_buffers() are empty
+    // afterwards
+    FlipGraphCSR<Mesh_t> finalize_csr();
+
+protected:
+    BasicTriangulationFlipGraph(std::shared_ptr<std::vector<Vec2> const> pts, FlipGraphEdgeMode edge_mode,
+                                FlipGraphSeed seed)
+        : coords_ptr_(std::move(pts)),
+          geometry_(std::make_shared<PointSetGeometry const>(coords_ptr_)),
+          edge_mode_(edge_mode),
+          seed_(seed)
+    {}
 
-private:
     std::shared_ptr<std::vector<Vec2> const> coords_ptr_;
+    std::shared_ptr<PointSetGeometry const>  geometry_;
+    FlipGraphEdgeMode                        edge_mode_;
+    FlipGraphSeed                            seed_;
     NodeSet_t                                nodes_;
     TrigEdgeSet_t                            edges_;
+    std::vector<EdgeBuffer_t>                edge_buffers_;
+};
+
+
+// Mesh is any triangulation type constructible from a std::shared_ptr<PointSetGeometry const> and exposing
+// triangulate(), flip_edge(), opposite_edge(), flippable(), fingerprint() and operator==, e.g.
+// MeshTriangulation2D<Traits> or MeshTriangulation2DBitset<MaxPoints>.
+//
+// The node sets store non-owning pointers so that a neighbour can be looked up with an in-place flipped scratch mesh
+// (see ScopedFlip) before deciding to copy it; the triangulations themselves live in storage_, one Arena per worker,
+// which is released in bulk on the next generate_graph() call.
+template<class Mesh>
+class TriangulationFlipGraph
+    : public BasicTriangulationFlipGraph<
+          Mesh, std::unordered_set<Mesh const*, MeshTriangulation2DCRefHash, MeshTriangulation2DCRefEqualTo>,
+          std::unordered_set<std::pair<Mesh const*, Mesh const*>, MeshTriangulation2DCRefEdgeHash,
+                             MeshTriangulation2DCRefEdgeEqualTo>>
+{
+    using Base = typename TriangulationFlipGraph::BasicTriangulationFlipGraph;
+    using typename Base::Mesh_t;
+    using typename Base::EdgeBuffer_t;
+    using Base::coords_ptr_;
+    using Base::edge_buffers_;
+    using Base::edge_mode_;
+    using Base::edges_;
+    using Base::geometry_;
+    using Base::nodes_;
+    using Base::seed_;
+
+public:
+    explicit TriangulationFlipGraph(std::shared_ptr<std::vector<Vec2> const> pts,
+                                    FlipGraphEdgeMode edge_mode = FlipGraphEdgeMode::Deduplicated,
+                                    FlipGraphSeed     seed      = FlipGraphSeed::SweepHull)
+        : Base(std::move(pts), edge_mode, seed)
+    {}
+
+    void generate_graph();
+
+private:
+    Arena<Mesh_t> storage_;
+};
+
+
+// Concurrent node sets usable with the concurrent engines: TBB's split-ordered list, or the fingerprint sharded
+// open-addressing ShardedNodeSet.
+template<class Mesh>
+using TbbNodeSet =
+    tbb::concurrent_unordered_set<Mesh const*, MeshTriangulation2DCRefHash, MeshTriangulation2DCRefEqualTo>;
+template<class Mesh>
+using ShardedMeshNodeSet = ShardedNodeSet<Mesh, MeshTriangulation2DCRefEqualTo>;
+
+template<class Mesh>
+using TbbEdgeSet = tbb::concurrent_unordered_set<std::pair<Mesh const*, Mesh const*>, MeshTriangulation2DCRefEdgeHash,
+                                                 MeshTriangulation2DCRefEdgeEqualTo>;
+
+
+// Second traits axis, next to the mesh traits: the containers of the concurrent graph engines. node_set_t<Mesh> and
+// edge_set_t<Mesh> hold the nodes and the deduplicated edges (FlipGraphEdgeMode::Deduplicated), work_queue_t<T> is
+// one of the queues of utils/work_queue.h.
+struct FlipGraphDefaultTraits
+{
+    template<class Mesh>
+    using node_set_t = TbbNodeSet<Mesh>;
+    template<class Mesh>
+    using edge_set_t = TbbEdgeSet<Mesh>;
+    template<class T>
+    using work_queue_t = MoodycamelWorkQueue<T>;
+};
+
+struct FlipGraphShardedTraits
+{
+    template<class Mesh>
+    using node_set_t = ShardedMeshNodeSet<Mesh>;
+    template<class Mesh>
+    using edge_set_t = TbbEdgeSet<Mesh>;
+    template<class T>
+    using work_queue_t = MoodycamelWorkQueue<T>;
+};
+
+struct FlipGraphWorkStealingTraits
+{
+    template<class Mesh>
+    using node_set_t = TbbNodeSet<Mesh>;
+    template<class Mesh>
+    using edge_set_t = TbbEdgeSet<Mesh>;
+    template<class T>
+    using work_queue_t = WorkStealingWorkQueue<T>;
+};
+
+struct FlipGraphShardedWorkStealingTraits
+{
+    template<class Mesh>
+    using node_set_t = ShardedMeshNodeSet<Mesh>;
+    template<class Mesh>
+    using edge_set_t = TbbEdgeSet<Mesh>;
+    template<class T>
+    using work_queue_t = WorkStealingWorkQueue<T>;
 };
 
 
-template<class MeshTraits>
+template<class Mesh, class GraphTraits = FlipGraphDefaultTraits>
 class ConcurrentTriangulationFlipGraph
+    : public BasicTriangulationFlipGraph<Mesh, typename GraphTraits::template node_set_t<Mesh>,
+                                         typename GraphTraits::template edge_set_t<Mesh>>
+{
+    using Base = typename ConcurrentTriangulationFlipGraph::BasicTriangulationFlipGraph;
+    using typename Base::Mesh_t;
+    using typename Base::EdgeBuffer_t;
+    using Base::coords_ptr_;
+    using Base::edge_buffers_;
+    using Base::edge_mode_;
+    using Base::edges_;
+    using Base::geometry_;
+    using Base::nodes_;
+    using Base::seed_;
+
+public:
+    explicit ConcurrentTriangulationFlipGraph(std::shared_ptr<std::vector<Vec2> const> pts,
+                                              FlipGraphEdgeMode edge_mode = FlipGraphEdgeMode::Deduplicated,
+                                              FlipGraphSeed     seed      = FlipGraphSeed::SweepHull)
+        : Base(std::move(pts), edge_mode, seed)
+    {}
+
+    // batch_size is the maximum number of states a worker dequeues at once
+    void generate_graph(size_t num_threads = 8, size_t batch_size = 1);
+
+private:
+    std::vector<Arena<Mesh_t>> storage_;
+};
+
+// ConcurrentTriangulationFlipGraph on TBB sets where every worker owns a WorkStealingDeque and steals from the others
+// when it runs dry. Workers only exit once no work item is pending anywhere, i.e. the graph is fully explored.
+template<class Mesh>
+using WorkStealingTriangulationFlipGraph = ConcurrentTriangulationFlipGraph<Mesh, FlipGraphWorkStealingTraits>;
+
+
+// Node-granular variant of ConcurrentTriangulationFlipGraph: a work item is a whole triangulation, expanded by a
+// single worker that flips every flippable edge on a scratch copy and flips it back afterwards.
+template<class Mesh, class GraphTraits = FlipGraphDefaultTraits>
+class ConcurrentNodeTriangulationFlipGraph
+    : public BasicTriangulationFlipGraph<Mesh, typename GraphTraits::template node_set_t<Mesh>,
+                                         typename GraphTraits::template edge_set_t<Mesh>>
 {
-    using Mesh_t    = MeshTriangulation2D<MeshTraits>;
-    using NodeSet_t = tbb::concurrent_unordered_set<std::unique_ptr<Mesh_t const>, MeshTriangulation2DCRefHash,
-                                                    MeshTriangulation2DCRefEqualTo>;
-    using TrigEdgeSet_t =
-        tbb::concurrent_unordered_set<std::pair<Mesh_t const*, Mesh_t const*>, MeshTriangulation2DCRefEdgeHash>;
+    using Base = typename ConcurrentNodeTriangulationFlipGraph::BasicTriangulationFlipGraph;
+    using typename Base::Mesh_t;
+    using typename Base::EdgeBuffer_t;
+    using Base::coords_ptr_;
+    using Base::edge_buffers_;
+    using Base::edge_mode_;
+    using Base::edges_;
+    using Base::geometry_;
+    using Base::nodes_;
+    using Base::seed_;
 
 public:
-    explicit ConcurrentTriangulationFlipGraph(std::shared_ptr<std::vector<Vec2> const> pts)
-        : coords_ptr_(std::move(pts))
+    explicit ConcurrentNodeTriangulationFlipGraph(std::shared_ptr<std::vector<Vec2> const> pts,
+                                                  FlipGraphEdgeMode edge_mode = FlipGraphEdgeMode::Deduplicated,
+                                                  FlipGraphSeed     seed      = FlipGraphSeed::SweepHull)
+        : Base(std::move(pts), edge_mode, seed)
     {}
 
-    void generate_graph(size_t num_threads = 8);
+    // batch_size is the maximum number of nodes a worker dequeues at once
+    void generate_graph(size_t num_threads = 8, size_t batch_size = 1);
+
+private:
+    std::vector<Arena<Mesh_t>> storage_;
+};
+
+
+struct FlipGraphCounts
+{
+    size_t num_nodes = 0;
+    size_t num_edges = 0;
+    // degree_histogram[d] is the number of triangulations with exactly d flippable edges
+    std::vector<size_t> degree_histogram;
+};
+
+// Counts the nodes and edges of the flip graph without keeping the triangulations. The BFS works on a single mesh that
+// it moves from node to node by replaying the flips of its BFS tree, so a node only costs its tree entry (parent and
+// flip) and its fingerprint. Visited triangulations are remembered by their 128-bit fingerprint alone, so a
+// fingerprint collision would merge two nodes (the same trade-off as TRIANGULATION_FLIP_GRAPH_TRUST_FINGERPRINT).
+template<class Mesh>
+class TriangulationFlipGraphCounter
+{
+    using Mesh_t = Mesh;
+#if MESH_TRIANGULATION_HAS_ABSL
+    using FingerprintSet_t = absl::flat_hash_set<Fingerprint128, Fingerprint128Hash>;
+#else
+    using FingerprintSet_t = std::unordered_set<Fingerprint128, Fingerprint128Hash>;
+#endif
+
+public:
+    explicit TriangulationFlipGraphCounter(std::shared_ptr<std::vector<Vec2> const> pts,
+                                           FlipGraphSeed seed = FlipGraphSeed::SweepHull)
+        : coords_ptr_(std::move(pts)),
+          geometry_(std::make_shared<PointSetGeometry const>(coords_ptr_)),
+          seed_(seed)
+    {}
 
-    NodeSet_t const&     nodes() const { return nodes_; }
-    TrigEdgeSet_t const& edges() const { return edges_; }
+    FlipGraphCounts const& count();
+    FlipGraphCounts const& counts() const { return counts_; }
 
 private:
+    // node of the BFS tree, reached from parent by flipping edge; flipping the new diagonal flipped goes back
+    struct TreeNode
+    {
+        size_t   parent = 0;
+        size_t   depth  = 0;
+        EdgeCell edge{};
+        EdgeCell flipped{};
+    };
+
+    // flip mesh from the triangulation of node from to the one of node to, through their lowest common ancestor
+    void move_to(Mesh_t& mesh, size_t from, size_t to);
+
     std::shared_ptr<std::vector<Vec2> const> coords_ptr_;
-    NodeSet_t                                nodes_;
-    TrigEdgeSet_t                            edges_;
+    std::shared_ptr<PointSetGeometry const>  geometry_;
+    FlipGraphSeed                            seed_;
+    FingerprintSet_t                         visited_;
+    std::vector<TreeNode>                    tree_;
+    std::vector<size_t>                      descent_;
+    FlipGraphCounts                          counts_;
 };
 
+
 // template<class MeshTraits>
 // class ConcurrentTriangulationFlipGraphCDS
 // {
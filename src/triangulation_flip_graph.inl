@@ -2,26 +2,123 @@
 #define CONVEX_TRIANGULATIONS_TRIANGULATIONFLIPGRAPH_INL
 
 
-#include "moodycamel/concurrent_queue.h"
+#include "utils/backoff.h"
 
+#include <algorithm>
+#include <atomic>
 
-template<class Traits>
-void TriangulationFlipGraph<Traits>::generate_graph()
+
+namespace detail
+{
+    // size hint for the node and edge sets of the engines: 2^(8 + n) for small point sets, clamped since the shift
+    // overflows an int beyond 22 points and the hash sets would allocate their buckets eagerly long before that
+    inline constexpr size_t max_reserve_hint = size_t{1} << 20;
+
+    constexpr size_t reserve_hint(size_t const num_points)
+    {
+        return num_points < 12 ? size_t{1} << (8 + num_points) : max_reserve_hint;
+    }
+
+    // copy src into the reusable scratch mesh, reusing its storage when it already exists
+    template<class Mesh>
+    void assign_scratch(std::unique_ptr<Mesh>& scratch, Mesh const& src)
+    {
+        if(scratch)
+            *scratch = src;
+        else
+            scratch = std::make_unique<Mesh>(src);
+    }
+
+    // look up the triangulation currently held by scratch and only copy it into storage if it is not a node yet,
+    // returns the stored node and whether it was inserted
+    template<class NodeSet, class Mesh>
+    std::pair<Mesh const*, bool> find_or_insert_copy(NodeSet& nodes, Mesh const& scratch, Arena<Mesh>& storage)
+    {
+        if(auto const it = nodes.find(&scratch); it != nodes.end())
+            return {*it, false};
+
+        Mesh const* new_triangulation_ptr = storage.create(scratch);
+        auto const [it, inserted]         = nodes.insert(new_triangulation_ptr);
+        if(!inserted)
+            storage.destroy_last();
+        return {*it, inserted};
+    }
+
+    // the endpoint with the smaller fingerprint owns an edge, the pointers only break ties between colliding
+    // fingerprints; both endpoints agree on the owner, so each edge is recorded by exactly one of its two flips
+    template<class Mesh>
+    bool owns_edge(Mesh const* from, Mesh const* to)
+    {
+        auto const& lhs = from->fingerprint();
+        auto const& rhs = to->fingerprint();
+        if(lhs.hi != rhs.hi)
+            return lhs.hi < rhs.hi;
+        if(lhs.lo != rhs.lo)
+            return lhs.lo < rhs.lo;
+        return std::less<Mesh const*>{}(from, to);
+    }
+
+    template<class EdgeSet, class Mesh>
+    void record_edge(FlipGraphEdgeMode const mode, EdgeSet& edges,
+                     std::vector<std::pair<Mesh const*, Mesh const*>>& edge_buffer, Mesh const* from, Mesh const* to)
+    {
+        if(mode == FlipGraphEdgeMode::Deduplicated)
+            edges.emplace(from, to);
+        else if(owns_edge(from, to))
+            edge_buffer.emplace_back(from, to);
+    }
+
+    // triangulate mesh and move it on to the requested seed triangulation
+    template<class Mesh>
+    typename Mesh::Result seed_triangulation(Mesh& mesh, FlipGraphSeed const seed, std::vector<Vec2> const& coords)
+    {
+        auto const res = mesh.triangulate();
+        if(res == Mesh::Result::Success && seed == FlipGraphSeed::Delaunay)
+            lawson_flip_to_delaunay(mesh, coords);
+        return res;
+    }
+
+    // workers fill a local edge buffer and only move it back into edge_buffers() once done, so that the buffer headers
+    // of different workers never share a cache line while they grow; the capacity of the previous run is reused
+    template<class EdgeBuffer>
+    EdgeBuffer take_edge_buffer(EdgeBuffer& edge_buffer)
+    {
+        EdgeBuffer res = std::move(edge_buffer);
+        res.clear();
+        return res;
+    }
+
+    template<class EdgeBuffer>
+    size_t count_edges(std::vector<EdgeBuffer> const& edge_buffers)
+    {
+        size_t count = 0;
+        for(auto const& edge_buffer: edge_buffers)
+            count += edge_buffer.size();
+        return count;
+    }
+} // namespace detail
+
+
+template<class Mesh>
+void TriangulationFlipGraph<Mesh>::generate_graph()
 {
     nodes_.clear();
     edges_.clear();
+    edge_buffers_.resize(1);
+    edge_buffers_.front().clear();
+    storage_.clear();
 
     // get seed triangulation from MeshTriangulation2D
-    auto seed = std::make_unique<Mesh_t>(coords_ptr_);
-    seed->triangulate();
+    Mesh_t* seed = storage_.create(geometry_);
+    detail::seed_triangulation(*seed, seed_, *coords_ptr_);
 
     std::queue<Mesh_t const*> bfs_queue_;
 
     // push seed into a lock-free queue
-    auto const insert_res0 = nodes_.insert(std::move(seed));
-    if(insert_res0.second)
-        bfs_queue_.push(insert_res0.first->get());
+    nodes_.insert(seed);
+    bfs_queue_.push(seed);
 
+    std::unique_ptr<Mesh_t> scratch;
     while(!bfs_queue_.empty())
     {
         auto const current_triangulation = bfs_queue_.front();
@@ -29,16 +126,16 @@ void TriangulationFlipGraph<Traits>::generate_graph()
 
         // fmt::println("Got: {}", current_triangulation->get_edge_adjacency().size());
 
+        detail::assign_scratch(scratch, *current_triangulation);
         for(auto const& edge: current_triangulation->flippable())
         {
-            auto new_triangulation_ptr = std::make_unique<Mesh_t>(*current_triangulation);
-            new_triangulation_ptr->flip_edge(edge);
+            ScopedFlip flip(*scratch, edge);
 
-            auto const insert_res = nodes_.insert(std::move(new_triangulation_ptr));
-            edges_.emplace(current_triangulation, insert_res.first->get());
-            if(insert_res.second)
+            auto const [ptr, inserted] = detail::find_or_insert_copy(nodes_, *scratch, storage_);
+            detail::record_edge(edge_mode_, edges_, edge_buffers_.front(), current_triangulation, ptr);
+            if(inserted)
             {
-                bfs_queue_.push(insert_res.first->get());
+                bfs_queue_.push(ptr);
             }
         }
         // current_triangulation = nullptr;
@@ -46,14 +143,28 @@ void TriangulationFlipGraph<Traits>::generate_graph()
 }
 
 
-template<class Traits>
-void ConcurrentTriangulationFlipGraph<Traits>::generate_graph(size_t const num_threads)
+// GCC 12 reports a spurious -Wstringop-overflow inside moodycamel's bulk enqueue once it gets inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstringop-overflow"
+#endif
+
+template<class Mesh, class GraphTraits>
+void ConcurrentTriangulationFlipGraph<Mesh, GraphTraits>::generate_graph(size_t const num_threads,
+                                                                         size_t const batch_size)
 {
     nodes_.clear();
     edges_.clear();
 
-    nodes_.reserve(1 << (8 + coords_ptr_->size()));
-    edges_.reserve(1 << (8 + coords_ptr_->size()));
+    nodes_.reserve(detail::reserve_hint(coords_ptr_->size()));
+    if(edge_mode_ == FlipGraphEdgeMode::Deduplicated)
+        edges_.reserve(detail::reserve_hint(coords_ptr_->size()));
+
+    // one arena per worker, kept across runs so that their blocks are reused
+    storage_.resize(std::max<size_t>(num_threads, 1));
+    for(auto& arena: storage_)
+        arena.clear();
+    edge_buffers_.resize(storage_.size());
 
 
     struct BFSState
@@ -67,48 +178,98 @@ void ConcurrentTriangulationFlipGraph<Traits>::generate_graph(size_t const num_t
               triangulation(tr)
         {}
     };
-    moodycamel::ConcurrentQueue<BFSState> bfs_queue_;
+    typename GraphTraits::template work_queue_t<BFSState> bfs_queue_(storage_.size());
+
+    // number of enqueued states that are not fully processed yet, an empty queue only means the exploration is over
+    // once no worker can enqueue new states anymore
+    std::atomic<size_t> pending{0};
 
     // get seed triangulation from MeshTriangulation2D
-    auto seed = std::make_unique<Mesh_t>(coords_ptr_);
-    seed->triangulate();
-    Mesh_t const* current_triangulation = nodes_.insert(std::move(seed)).first->get();
+    Mesh_t* seed = storage_.front().create(geometry_);
+    detail::seed_triangulation(*seed, seed_, *coords_ptr_);
+    Mesh_t const* current_triangulation = *nodes_.insert(seed).first;
 
     for(auto&& eg: current_triangulation->flippable())
-        bfs_queue_.enqueue(BFSState(eg, current_triangulation));
+    {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        bfs_queue_.push(BFSState(eg, current_triangulation));
+    }
+
+
+    // flip a dequeued state in place on the worker scratch mesh and collect the states of the new triangulation, if
+    // it was not known yet. Consecutive states usually share their triangulation, the scratch mesh is only reloaded
+    // when it changes since ScopedFlip restores it after every flip.
+    struct Scratch
+    {
+        std::unique_ptr<Mesh_t> mesh;
+        Mesh_t const*           source{};
+    };
+    auto expand = [&](BFSState const& state, Scratch& scratch, Arena<Mesh_t>& storage, EdgeBuffer_t& edge_buffer,
+                      std::vector<BFSState>& children)
+    {
+        if(scratch.source != state.triangulation)
+        {
+            detail::assign_scratch(scratch.mesh, *state.triangulation);
+            scratch.source = state.triangulation;
+        }
 
+        ScopedFlip flip(*scratch.mesh, state.edge);
 
-    // constexpr size_t NUM_THREADS = 8;
+        auto const [ptr, inserted] = detail::find_or_insert_copy(nodes_, *scratch.mesh, storage);
+        detail::record_edge(edge_mode_, edges_, edge_buffer, state.triangulation, ptr);
+
+        if(inserted)
+        {
+            for(auto&& eg: ptr->flippable())
+                children.emplace_back(eg, ptr);
+        }
+    };
 
-    auto worker = [&](size_t)
+    // each worker owns a queue handle, pulls up to batch_size states at once and pushes all the children of a batch
+    // with a single bulk enqueue
+    auto worker = [&](size_t const idx)
     {
-        // size_t counter = 0;
-        BFSState state{};
-        while(bfs_queue_.try_dequeue(state))
+        auto handle = bfs_queue_.handle(idx);
+
+        auto&                 storage     = storage_[idx];
+        auto                  edge_buffer = detail::take_edge_buffer(edge_buffers_[idx]);
+        Scratch               scratch;
+        Backoff               backoff;
+        std::vector<BFSState> batch(std::max<size_t>(batch_size, 1));
+        std::vector<BFSState> children;
+        while(true)
         {
-            auto new_triangulation_ptr = std::make_unique<Mesh_t>(*state.triangulation);
-            new_triangulation_ptr->flip_edge(state.edge);
+            size_t const count = bfs_queue_.try_pop_bulk(handle, batch.begin(), batch.size());
+            if(count == 0)
+            {
+                if(pending.load(std::memory_order_acquire) == 0)
+                    break;
+                backoff();
+                continue;
+            }
+            backoff.reset();
 
-            auto const [ptr, inserted] = nodes_.emplace(std::move(new_triangulation_ptr));
-            edges_.emplace(state.triangulation, ptr->get());
+            children.clear();
+            for(size_t i = 0; i < count; ++i)
+                expand(batch[i], scratch, storage, edge_buffer, children);
 
-            if(inserted)
+            if(!children.empty())
             {
-                for(auto&& eg: ptr->get()->flippable())
-                    bfs_queue_.enqueue(BFSState(eg, ptr->get()));
+                pending.fetch_add(children.size(), std::memory_order_relaxed);
+                bfs_queue_.push_bulk(handle, children.begin(), children.size());
             }
-            // ++counter;
+
+            pending.fetch_sub(count, std::memory_order_acq_rel);
         }
-        // spdlog::info("Thread {} finished with {} flips", idx, counter);
+        edge_buffers_[idx] = std::move(edge_buffer);
     };
 
     std::vector<std::thread> threads;
-    threads.reserve(num_threads);
-    for(size_t t = 0; t < num_threads; ++t)
+    threads.reserve(storage_.size());
+    for(size_t t = 0; t < storage_.size(); ++t)
     {
         threads.emplace_back(worker, t);
     }
-    // worker(num_threads);
 
     for(auto& thread: threads)
     {
@@ -117,4 +278,195 @@ void ConcurrentTriangulationFlipGraph<Traits>::generate_graph(size_t const num_t
     }
 }
 
+
+template<class Mesh, class GraphTraits>
+void ConcurrentNodeTriangulationFlipGraph<Mesh, GraphTraits>::generate_graph(size_t const num_threads,
+                                                                             size_t const batch_size)
+{
+    nodes_.clear();
+    edges_.clear();
+
+    nodes_.reserve(detail::reserve_hint(coords_ptr_->size()));
+    if(edge_mode_ == FlipGraphEdgeMode::Deduplicated)
+        edges_.reserve(detail::reserve_hint(coords_ptr_->size()));
+
+    // one arena per worker, kept across runs so that their blocks are reused
+    storage_.resize(std::max<size_t>(num_threads, 1));
+    for(auto& arena: storage_)
+        arena.clear();
+    edge_buffers_.resize(storage_.size());
+
+    typename GraphTraits::template work_queue_t<Mesh_t const*> bfs_queue_(storage_.size());
+
+    // number of enqueued nodes that are not fully expanded yet
+    std::atomic<size_t> pending{0};
+
+    // get seed triangulation from MeshTriangulation2D
+    Mesh_t* seed = storage_.front().create(geometry_);
+    detail::seed_triangulation(*seed, seed_, *coords_ptr_);
+    nodes_.insert(seed);
+    pending.fetch_add(1, std::memory_order_relaxed);
+    bfs_queue_.push(seed);
+
+    auto worker = [&](size_t const idx)
+    {
+        auto handle = bfs_queue_.handle(idx);
+
+        auto&                      storage     = storage_[idx];
+        auto                       edge_buffer = detail::take_edge_buffer(edge_buffers_[idx]);
+        std::unique_ptr<Mesh_t>    scratch;
+        Backoff                    backoff;
+        std::vector<Mesh_t const*> batch(std::max<size_t>(batch_size, 1));
+        std::vector<Mesh_t const*> children;
+        while(true)
+        {
+            size_t const count = bfs_queue_.try_pop_bulk(handle, batch.begin(), batch.size());
+            if(count == 0)
+            {
+                if(pending.load(std::memory_order_acquire) == 0)
+                    break;
+                backoff();
+                continue;
+            }
+            backoff.reset();
+
+            children.clear();
+            for(size_t i = 0; i < count; ++i)
+            {
+                Mesh_t const* current_triangulation = batch[i];
+                detail::assign_scratch(scratch, *current_triangulation);
+
+                for(auto&& eg: current_triangulation->flippable())
+                {
+                    ScopedFlip flip(*scratch, eg);
+
+                    auto const [ptr, inserted] = detail::find_or_insert_copy(nodes_, *scratch, storage);
+                    detail::record_edge(edge_mode_, edges_, edge_buffer, current_triangulation, ptr);
+                    if(inserted)
+                        children.push_back(ptr);
+                }
+            }
+
+            if(!children.empty())
+            {
+                pending.fetch_add(children.size(), std::memory_order_relaxed);
+                bfs_queue_.push_bulk(handle, children.begin(), children.size());
+            }
+
+            pending.fetch_sub(count, std::memory_order_acq_rel);
+        }
+        edge_buffers_[idx] = std::move(edge_buffer);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(storage_.size());
+    for(size_t t = 0; t < storage_.size(); ++t)
+    {
+        threads.emplace_back(worker, t);
+    }
+
+    for(auto& thread: threads)
+    {
+        if(thread.joinable())
+            thread.join();
+    }
+}
+
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+
+template<class Mesh>
+FlipGraphCounts const& TriangulationFlipGraphCounter<Mesh>::count()
+{
+    visited_.clear();
+    tree_.clear();
+    counts_ = FlipGraphCounts{};
+
+    Mesh_t mesh(geometry_);
+    if(detail::seed_triangulation(mesh, seed_, *coords_ptr_) != Mesh_t::Result::Success)
+        return counts_;
+
+    visited_.insert(mesh.fingerprint());
+    tree_.emplace_back();
+
+    // the tree is filled in BFS order, so it doubles as the queue; mesh holds the triangulation of node current
+    size_t                current   = 0;
+    size_t                num_flips = 0;
+    std::vector<EdgeCell> candidates;
+    for(size_t node = 0; node < tree_.size(); ++node)
+    {
+        move_to(mesh, current, node);
+        current = node;
+
+        // mesh is flipped while the candidates are tried, so its flippable edges are copied first
+        candidates.assign(mesh.flippable().begin(), mesh.flippable().end());
+        size_t const depth = tree_[node].depth + 1;
+        for(auto const& edge: candidates)
+        {
+            ScopedFlip flip(mesh, edge);
+            if(visited_.insert(mesh.fingerprint()).second)
+                tree_.push_back(TreeNode{node, depth, edge, flip.flipped_edge()});
+        }
+
+        size_t const degree = candidates.size();
+        if(degree >= counts_.degree_histogram.size())
+            counts_.degree_histogram.resize(degree + 1, 0);
+        ++counts_.degree_histogram[degree];
+        num_flips += degree;
+    }
+
+    // every flip is seen from both of its triangulations
+    counts_.num_nodes = visited_.size();
+    counts_.num_edges = num_flips / 2;
+    return counts_;
+}
+
+
+template<class Mesh>
+void TriangulationFlipGraphCounter<Mesh>::move_to(Mesh_t& mesh, size_t from, size_t to)
+{
+    descent_.clear();
+    while(tree_[to].depth > tree_[from].depth)
+    {
+        descent_.push_back(to);
+        to = tree_[to].parent;
+    }
+    while(tree_[from].depth > tree_[to].depth)
+    {
+        mesh.flip_edge(tree_[from].flipped);
+        from = tree_[from].parent;
+    }
+    while(from != to)
+    {
+        mesh.flip_edge(tree_[from].flipped);
+        from = tree_[from].parent;
+        descent_.push_back(to);
+        to = tree_[to].parent;
+    }
+
+    for(auto it = descent_.rbegin(); it != descent_.rend(); ++it)
+        mesh.flip_edge(tree_[*it].edge);
+}
+
+
+template<class Mesh, class NodeSet, class EdgeSet>
+size_t BasicTriangulationFlipGraph<Mesh, NodeSet, EdgeSet>::num_edges() const
+{
+    return edges_.size() + detail::count_edges(edge_buffers_);
+}
+
+
+template<class Mesh, class NodeSet, class EdgeSet>
+FlipGraphCSR<Mesh> BasicTriangulationFlipGraph<Mesh, NodeSet, EdgeSet>::finalize_csr()
+{
+    auto csr      = make_flip_graph_csr<Mesh_t>(nodes_, edges_, edge_buffers_);
+    edges_        = TrigEdgeSet_t{};
+    edge_buffers_ = std::vector<EdgeBuffer_t>{};
+    return csr;
+}
+
+
 #endif // CONVEX_TRIANGULATIONS_TRIANGULATIONFLIPGRAPH_INL
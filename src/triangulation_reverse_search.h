@@ -0,0 +1,100 @@
+#ifndef CONVEX_TRIANGULATIONS_TRIANGULATIONREVERSESEARCH_HPP
+#define CONVEX_TRIANGULATIONS_TRIANGULATIONREVERSESEARCH_HPP
+
+#include "delaunay.h"
+#include "mesh_cell.h"
+#include "point_set_geometry.h"
+#include "vec2.h"
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+// one level of the depth-first reverse search walk: the flippable edges of the mesh at that level, the next one to
+// try and the edge flipping back to the parent level (undefined at the root of a walk)
+struct ReverseSearchFrame
+{
+    std::vector<EdgeCell> candidates;
+    size_t                next = 0;
+    EdgeCell              parent_edge{};
+};
+
+
+// Enumerates all triangulations of a point set by reverse search (Avis & Fukuda). The Lawson flip of a triangulation
+// (see lawson_flip_edge) defines its parent, which turns the flip graph into a tree rooted at the Delaunay
+// triangulation. The tree is walked depth-first on a single mesh that is flipped in place and flipped back, a flip
+// leads to a child iff the new diagonal is the Lawson flip edge of the result. Nothing is stored per visited node, so
+// memory grows with the depth of the tree instead of the size of the graph.
+//
+// Mesh is any triangulation type constructible from a std::shared_ptr<PointSetGeometry const> and exposing
+// triangulate(), flip_edge(), opposite_edge() and flippable().
+template<class Mesh>
+class ReverseSearchTriangulationEnumerator
+{
+    using Mesh_t = Mesh;
+
+public:
+    explicit ReverseSearchTriangulationEnumerator(std::shared_ptr<std::vector<Vec2> const> pts)
+        : coords_ptr_(std::move(pts)),
+          geometry_(std::make_shared<PointSetGeometry const>(coords_ptr_))
+    {}
+
+    // visit(Mesh const&) is called exactly once per triangulation, the flip edges of the graph are the flippable()
+    // edges of the visited meshes
+    template<class Visitor>
+    void enumerate(Visitor&& visit);
+    void enumerate();
+
+    size_t num_nodes() const { return num_nodes_; }
+    size_t num_edges() const { return num_edges_; }
+    size_t max_depth() const { return max_depth_; }
+
+private:
+    std::shared_ptr<std::vector<Vec2> const> coords_ptr_;
+    std::shared_ptr<PointSetGeometry const>  geometry_;
+    std::vector<ReverseSearchFrame>          stack_;
+    size_t                                   num_nodes_ = 0;
+    size_t                                   num_edges_ = 0;
+    size_t                                   max_depth_ = 0;
+};
+
+
+// Parallel ReverseSearchTriangulationEnumerator. Each worker walks a subtree depth-first; after budget nodes of a
+// subtree it hands the children it finds to the shared queue instead of entering them, as long as fewer subtrees than
+// workers are queued. Workers share nothing but that queue, there is no visited set to synchronise on.
+template<class Mesh>
+class ParallelReverseSearchTriangulationEnumerator
+{
+    using Mesh_t = Mesh;
+
+public:
+    explicit ParallelReverseSearchTriangulationEnumerator(std::shared_ptr<std::vector<Vec2> const> pts)
+        : coords_ptr_(std::move(pts)),
+          geometry_(std::make_shared<PointSetGeometry const>(coords_ptr_))
+    {}
+
+    // visit(Mesh const&, size_t worker) is called exactly once per triangulation, concurrently from all workers; the
+    // constraint keeps enumerate(num_threads, budget) with int arguments from binding num_threads as the visitor
+    template<class Visitor, std::enable_if_t<std::is_invocable_v<Visitor&, Mesh const&, size_t>, int> = 0>
+    void enumerate(Visitor&& visit, size_t num_threads = 8, size_t budget = 256);
+    void enumerate(size_t num_threads = 8, size_t budget = 256);
+
+    size_t num_nodes() const { return num_nodes_; }
+    size_t num_edges() const { return num_edges_; }
+    size_t max_depth() const { return max_depth_; }
+
+private:
+    std::shared_ptr<std::vector<Vec2> const>     coords_ptr_;
+    std::shared_ptr<PointSetGeometry const>      geometry_;
+    std::vector<std::vector<ReverseSearchFrame>> stacks_;
+    size_t                                       num_nodes_ = 0;
+    size_t                                       num_edges_ = 0;
+    size_t                                       max_depth_ = 0;
+};
+
+
+#include "triangulation_reverse_search.inl"
+
+#endif // CONVEX_TRIANGULATIONS_TRIANGULATIONREVERSESEARCH_HPP
@@ -0,0 +1,226 @@
+#ifndef CONVEX_TRIANGULATIONS_TRIANGULATIONREVERSESEARCH_INL
+#define CONVEX_TRIANGULATIONS_TRIANGULATIONREVERSESEARCH_INL
+
+#include "moodycamel/concurrent_queue.h"
+#include "utils/backoff.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <thread>
+
+
+namespace detail
+{
+    // flippable edges of mesh in EdgeCell::index() order, so that the walk does not depend on hash set iteration
+    template<class Mesh>
+    void sorted_flippable(Mesh const& mesh, std::vector<EdgeCell>& edges)
+    {
+        edges.clear();
+        for(auto const& edge: mesh.flippable())
+            edges.push_back(edge);
+        std::sort(edges.begin(), edges.end(),
+                  [](EdgeCell const& lhs, EdgeCell const& rhs) { return lhs.index() < rhs.index(); });
+    }
+
+    // Depth-first walk of the reverse search subtree rooted at mesh, which is restored when the walk returns.
+    // on_node(mesh, degree, depth) is called for every node of the subtree, descend(mesh, depth) for every child
+    // before it is entered: returning false skips the child subtree, e.g. because it was handed to another worker.
+    template<class Mesh, class OnNode, class Descend>
+    void reverse_search_subtree(Mesh& mesh, std::vector<Vec2> const& coords, size_t const root_depth,
+                                std::vector<ReverseSearchFrame>& stack, OnNode&& on_node, Descend&& descend)
+    {
+        // the frames are kept across calls to reuse their candidate buffers, depth is the number of live frames
+        size_t depth = 0;
+        auto   push  = [&](EdgeCell const parent_edge)
+        {
+            if(depth == stack.size())
+                stack.emplace_back();
+            ReverseSearchFrame& frame = stack[depth++];
+            sorted_flippable(mesh, frame.candidates);
+            frame.next        = 0;
+            frame.parent_edge = parent_edge;
+
+            on_node(static_cast<Mesh const&>(mesh), frame.candidates.size(), root_depth + depth - 1);
+        };
+
+        push(EdgeCell());
+        while(depth > 0)
+        {
+            ReverseSearchFrame& frame = stack[depth - 1];
+            if(frame.next == frame.candidates.size())
+            {
+                // subtree done, go back to the parent
+                if(!frame.parent_edge.undefined())
+                    mesh.flip_edge(frame.parent_edge);
+                --depth;
+                continue;
+            }
+
+            EdgeCell const edge    = frame.candidates[frame.next++];
+            EdgeCell const flipped = mesh.opposite_edge(edge);
+            if(frame.parent_edge == edge || mesh.flip_edge(edge) != Mesh::Result::Success)
+                continue;
+
+            bool const is_child = is_lawson_flip_edge(mesh, coords, flipped);
+            if(is_child && descend(static_cast<Mesh const&>(mesh), root_depth + depth))
+                push(flipped);
+            else
+                mesh.flip_edge(flipped);
+        }
+    }
+} // namespace detail
+
+
+template<class Mesh>
+void ReverseSearchTriangulationEnumerator<Mesh>::enumerate()
+{
+    enumerate([](Mesh_t const&) {});
+}
+
+
+template<class Mesh>
+template<class Visitor>
+void ReverseSearchTriangulationEnumerator<Mesh>::enumerate(Visitor&& visit)
+{
+    num_nodes_ = 0;
+    num_edges_ = 0;
+    max_depth_ = 0;
+
+    Mesh_t mesh(geometry_);
+    if(mesh.triangulate() != Mesh_t::Result::Success)
+        return;
+    lawson_flip_to_delaunay(mesh, *coords_ptr_);
+
+    detail::reverse_search_subtree(
+        mesh, *coords_ptr_, 0, stack_,
+        [&](Mesh_t const& node, size_t const degree, size_t const depth)
+        {
+            visit(node);
+            ++num_nodes_;
+            num_edges_ += degree;
+            max_depth_ = std::max(max_depth_, depth);
+        },
+        [](Mesh_t const&, size_t) { return true; });
+
+    // every flip edge was counted from both of its triangulations
+    num_edges_ /= 2;
+}
+
+
+template<class Mesh>
+void ParallelReverseSearchTriangulationEnumerator<Mesh>::enumerate(size_t const num_threads, size_t const budget)
+{
+    enumerate([](Mesh_t const&, size_t) {}, num_threads, budget);
+}
+
+
+template<class Mesh>
+template<class Visitor, std::enable_if_t<std::is_invocable_v<Visitor&, Mesh const&, size_t>, int>>
+void ParallelReverseSearchTriangulationEnumerator<Mesh>::enumerate(Visitor&& visit, size_t const num_threads,
+                                                                    size_t const budget)
+{
+    num_nodes_ = 0;
+    num_edges_ = 0;
+    max_depth_ = 0;
+
+    auto root = std::make_unique<Mesh_t>(geometry_);
+    if(root->triangulate() != Mesh_t::Result::Success)
+        return;
+    lawson_flip_to_delaunay(*root, *coords_ptr_);
+
+    // a work item is the root of an unexplored subtree, together with its depth in the whole tree
+    struct Subtree
+    {
+        std::unique_ptr<Mesh_t> mesh;
+        size_t                  depth = 0;
+    };
+    moodycamel::ConcurrentQueue<Subtree> subtrees;
+
+    // number of enqueued subtrees that are not fully explored yet
+    std::atomic<size_t> pending{1};
+    subtrees.enqueue(Subtree{std::move(root), 0});
+
+    std::atomic<size_t> num_nodes{0};
+    std::atomic<size_t> num_edges{0};
+    std::atomic<size_t> max_depth{0};
+
+    size_t const num_workers = std::max<size_t>(num_threads, 1);
+    stacks_.resize(num_workers);
+
+    auto worker = [&](size_t const idx)
+    {
+        moodycamel::ProducerToken producer_token(subtrees);
+        moodycamel::ConsumerToken consumer_token(subtrees);
+
+        size_t  local_nodes = 0;
+        size_t  local_edges = 0;
+        size_t  local_depth = 0;
+        Backoff backoff;
+        Subtree subtree;
+        while(true)
+        {
+            if(!subtrees.try_dequeue(consumer_token, subtree))
+            {
+                if(pending.load(std::memory_order_acquire) == 0)
+                    break;
+                backoff();
+                continue;
+            }
+            backoff.reset();
+
+            // explore up to budget nodes of the subtree, then hand the children that are found afterwards to the
+            // other workers as long as the queue runs low, so that idle threads get work without any shared state
+            size_t visited = 0;
+            detail::reverse_search_subtree(
+                *subtree.mesh, *coords_ptr_, subtree.depth, stacks_[idx],
+                [&](Mesh_t const& node, size_t const degree, size_t const depth)
+                {
+                    visit(node, idx);
+                    ++visited;
+                    local_edges += degree;
+                    local_depth = std::max(local_depth, depth);
+                },
+                [&](Mesh_t const& child, size_t const depth)
+                {
+                    if(visited < budget || subtrees.size_approx() >= num_workers)
+                        return true;
+
+                    pending.fetch_add(1, std::memory_order_relaxed);
+                    subtrees.enqueue(producer_token, Subtree{std::make_unique<Mesh_t>(child), depth});
+                    return false;
+                });
+            local_nodes += visited;
+            subtree.mesh.reset();
+
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        num_nodes.fetch_add(local_nodes, std::memory_order_relaxed);
+        num_edges.fetch_add(local_edges, std::memory_order_relaxed);
+        for(size_t seen = max_depth.load(std::memory_order_relaxed);
+            seen < local_depth && !max_depth.compare_exchange_weak(seen, local_depth, std::memory_order_relaxed);)
+        {
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_workers);
+    for(size_t t = 0; t < num_workers; ++t)
+    {
+        threads.emplace_back(worker, t);
+    }
+
+    for(auto& thread: threads)
+    {
+        if(thread.joinable())
+            thread.join();
+    }
+
+    num_nodes_ = num_nodes.load();
+    // every flip edge was counted from both of its triangulations
+    num_edges_ = num_edges.load() / 2;
+    max_depth_ = max_depth.load();
+}
+
+#endif // CONVEX_TRIANGULATIONS_TRIANGULATIONREVERSESEARCH_INL
@@ -0,0 +1,125 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Single-owner slab allocator: objects are constructed into fixed-size blocks with a pointer bump and are only ever
+// released all at once. clear() destroys the objects but keeps the blocks, so refilling the arena (e.g. generating the
+// same graph again) does not go back to the system allocator. Not thread-safe, use one arena per worker.
+template<class T>
+class alignas(64) Arena
+{
+    struct Slot
+    {
+        alignas(T) std::byte bytes[sizeof(T)];
+    };
+
+public:
+    explicit Arena(size_t block_size = 1024)
+        : block_size_(block_size > 0 ? block_size : 1)
+    {}
+
+    Arena(Arena&& other) noexcept
+        : block_size_(other.block_size_),
+          blocks_(std::move(other.blocks_)),
+          block_idx_(std::exchange(other.block_idx_, 0)),
+          used_(std::exchange(other.used_, 0)),
+          size_(std::exchange(other.size_, 0))
+    {}
+
+    Arena& operator=(Arena&& other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            block_size_ = other.block_size_;
+            blocks_     = std::move(other.blocks_);
+            block_idx_  = std::exchange(other.block_idx_, 0);
+            used_       = std::exchange(other.used_, 0);
+            size_       = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    Arena(Arena const&)            = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    ~Arena() { release(); }
+
+    template<class... Args>
+    T* create(Args&&... args)
+    {
+        if(blocks_.empty() || used_ == block_size_)
+            next_block();
+
+        T* obj = ::new(static_cast<void*>(blocks_[block_idx_][used_].bytes)) T(std::forward<Args>(args)...);
+        ++used_;
+        ++size_;
+        return obj;
+    }
+
+    // destroy the most recently created object, e.g. after losing an insertion race
+    void destroy_last()
+    {
+        assert(size_ > 0);
+        if(used_ == 0)
+        {
+            --block_idx_;
+            used_ = block_size_;
+        }
+        --used_;
+        --size_;
+        std::launder(reinterpret_cast<T*>(blocks_[block_idx_][used_].bytes))->~T();
+    }
+
+    // destroy all objects, the blocks are kept for reuse
+    void clear()
+    {
+        if constexpr(!std::is_trivially_destructible_v<T>)
+        {
+            for(size_t b = 0; b < blocks_.size() && b <= block_idx_; ++b)
+            {
+                size_t const count = b < block_idx_ ? block_size_ : used_;
+                for(size_t i = 0; i < count; ++i)
+                    std::launder(reinterpret_cast<T*>(blocks_[b][i].bytes))->~T();
+            }
+        }
+        block_idx_ = 0;
+        used_      = 0;
+        size_      = 0;
+    }
+
+    // destroy all objects and give the blocks back to the system
+    void release()
+    {
+        clear();
+        blocks_.clear();
+    }
+
+    size_t size() const { return size_; }
+    bool   empty() const { return size_ == 0; }
+
+private:
+    size_t                               block_size_;
+    std::vector<std::unique_ptr<Slot[]>> blocks_;
+    size_t                               block_idx_ = 0;
+    size_t                               used_      = 0;
+    size_t                               size_      = 0;
+
+    void next_block()
+    {
+        if(!blocks_.empty())
+            ++block_idx_;
+        if(block_idx_ == blocks_.size())
+            blocks_.push_back(std::unique_ptr<Slot[]>(new Slot[block_size_]));
+        used_ = 0;
+    }
+};
+
+#endif // ARENA_H
@@ -0,0 +1,39 @@
+#ifndef BACKOFF_H
+#define BACKOFF_H
+
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+// Idle strategy for workers waiting on work produced by other threads: yield for the first few rounds, then sleep
+// so that idle cores do not keep spinning while the remaining workers finish.
+class Backoff
+{
+public:
+    explicit Backoff(size_t yield_limit = 64, std::chrono::microseconds sleep = std::chrono::microseconds(50))
+        : yield_limit_(yield_limit),
+          sleep_(sleep)
+    {}
+
+    void operator()()
+    {
+        if(count_ < yield_limit_)
+        {
+            ++count_;
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(sleep_);
+        }
+    }
+
+    void reset() { count_ = 0; }
+
+private:
+    size_t                    count_{};
+    size_t                    yield_limit_;
+    std::chrono::microseconds sleep_;
+};
+
+#endif // BACKOFF_H
@@ -0,0 +1,53 @@
+#ifndef BITS_H
+#define BITS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+struct BitUtils
+{
+    // index of the lowest set bit, x must be non-zero
+    static inline int countr_zero(uint64_t x) noexcept
+    {
+#if defined(_MSC_VER)
+        unsigned long idx = 0;
+        _BitScanForward64(&idx, x);
+        return static_cast<int>(idx);
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+
+    static inline int popcount(uint64_t x) noexcept
+    {
+#if defined(_MSC_VER)
+        return static_cast<int>(__popcnt64(x));
+#else
+        return __builtin_popcountll(x);
+#endif
+    }
+
+    // number of bits set in both lhs and rhs, over num_words words
+    static inline size_t popcount_and(uint64_t const* lhs, uint64_t const* rhs, size_t num_words) noexcept
+    {
+        size_t count = 0;
+        for(size_t i = 0; i < num_words; ++i)
+            count += popcount(lhs[i] & rhs[i]);
+        return count;
+    }
+
+    // number of bits set in lhs but not in rhs, over num_words words
+    static inline size_t popcount_and_not(uint64_t const* lhs, uint64_t const* rhs, size_t num_words) noexcept
+    {
+        size_t count = 0;
+        for(size_t i = 0; i < num_words; ++i)
+            count += popcount(lhs[i] & ~rhs[i]);
+        return count;
+    }
+};
+
+#endif // BITS_H
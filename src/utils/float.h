@@ -0,0 +1,22 @@
+#ifndef CONVEX_TRIANGULATIONS_FLOAT_HPP
+#define CONVEX_TRIANGULATIONS_FLOAT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace detail
+{
+    template<class T, class U>
+    bool is_same_epsilon(T a, U b)
+    {
+        using diff_t = std::common_type_t<T, U>;
+        diff_t const max_epsilon =
+            std::max<diff_t>(std::numeric_limits<T>::epsilon(), std::numeric_limits<U>::epsilon());
+        diff_t const diff = std::abs(a - b);
+        return diff < 3 * max_epsilon;
+    }
+} // namespace detail
+
+#endif // CONVEX_TRIANGULATIONS_FLOAT_HPP
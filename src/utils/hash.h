@@ -4,6 +4,36 @@
 #include <cstdint>
 #include <utility>
 
+// 128-bit order-independent fingerprint, two independently mixed 64-bit sums so that it can be updated incrementally
+// with the same add/subtract deltas as HashUtils::combine_unordered_range
+struct Fingerprint128
+{
+    uint64_t lo{};
+    uint64_t hi{};
+
+    constexpr Fingerprint128& operator+=(Fingerprint128 const& rhs)
+    {
+        lo += rhs.lo;
+        hi += rhs.hi;
+        return *this;
+    }
+    constexpr Fingerprint128& operator-=(Fingerprint128 const& rhs)
+    {
+        lo -= rhs.lo;
+        hi -= rhs.hi;
+        return *this;
+    }
+
+    constexpr bool operator==(Fingerprint128 const& rhs) const { return lo == rhs.lo && hi == rhs.hi; }
+    constexpr bool operator!=(Fingerprint128 const& rhs) const { return !(*this == rhs); }
+};
+
+// both halves are already well mixed sums of hashes, either can be used as a hash value directly
+struct Fingerprint128Hash
+{
+    constexpr size_t operator()(Fingerprint128 const& fp) const noexcept { return fp.lo; }
+};
+
 struct HashUtils
 {
     static constexpr uint64_t combine(uint64_t seed, uint64_t hash)
@@ -16,10 +46,28 @@ struct HashUtils
     {
         uint64_t r = 0;
         for( ; first != last; ++first )
-            r += mixin(0x9e3779b9 + hasher(*first));
+            r += unordered_element(hasher(*first));
         return r;
     }
 
+    // contribution of a single element to combine_unordered_range, allows updating the combined hash incrementally
+    // by adding or subtracting elements
+    static constexpr uint64_t unordered_element(uint64_t hash)
+    {
+        return mixin(0x9e3779b9 + hash);
+    }
+
+    static constexpr Fingerprint128 unordered_element128(uint64_t hash)
+    {
+        return Fingerprint128{unordered_element(hash), splitmix(hash)};
+    }
+
+    // well distributed hash of a single integer key, e.g. for open addressing tables that use the low bits
+    static constexpr uint64_t mix(uint64_t key)
+    {
+        return mixin(key);
+    }
+
     template<class T1, class T2, class HashFunction>
     static constexpr uint64_t combine_unordered_pair(std::pair<T1, T2> const& p, HashFunction hasher)
     {
@@ -37,6 +85,13 @@ private:
         x ^= x >> 28;
         return x;
     }
+    static constexpr uint64_t splitmix(uint64_t x)
+    {
+        x += 0x9e3779b97f4a7c15;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+        return x ^ (x >> 31);
+    }
 };
 
 #endif // HASH_H
\ No newline at end of file
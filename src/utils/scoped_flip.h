@@ -0,0 +1,40 @@
+#ifndef SCOPED_FLIP_H
+#define SCOPED_FLIP_H
+
+#include "mesh_cell.h"
+
+// Flips an edge of a mesh in place and flips the new diagonal back when going out of scope, restoring the original
+// triangulation without copying it (a flip is its own inverse). Works with any mesh exposing flip_edge() and
+// opposite_edge().
+template<class Mesh>
+class ScopedFlip
+{
+public:
+    ScopedFlip(Mesh& mesh, EdgeCell const edge)
+        : mesh_(mesh),
+          flipped_(mesh.opposite_edge(edge)),
+          flipped_ok_(mesh.flip_edge(edge) == Mesh::Result::Success)
+    {}
+
+    ScopedFlip(ScopedFlip const&)            = delete;
+    ScopedFlip& operator=(ScopedFlip const&) = delete;
+
+    ~ScopedFlip() { restore(); }
+
+    explicit operator bool() const { return flipped_ok_; }
+    EdgeCell flipped_edge() const { return flipped_; }
+
+    void restore()
+    {
+        if(flipped_ok_)
+            mesh_.flip_edge(flipped_);
+        flipped_ok_ = false;
+    }
+
+private:
+    Mesh&    mesh_;
+    EdgeCell flipped_;
+    bool     flipped_ok_;
+};
+
+#endif // SCOPED_FLIP_H
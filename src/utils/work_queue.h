@@ -0,0 +1,92 @@
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+#include "work_stealing_deque.h"
+
+#include <cstddef>
+#include <moodycamel/concurrent_queue.h>
+#include <vector>
+
+// Work queues for the concurrent flip graph engines, all with the same interface: push() seeds the queue before the
+// workers start, every worker then takes a handle() once and pushes / pops in bulk through it.
+
+
+// single shared lock-free queue, the handle holds the worker's producer and consumer tokens
+template<class T>
+class MoodycamelWorkQueue
+{
+public:
+    struct Handle
+    {
+        moodycamel::ProducerToken producer;
+        moodycamel::ConsumerToken consumer;
+    };
+
+    explicit MoodycamelWorkQueue(size_t /*num_workers*/) {}
+
+    void   push(T const& value) { queue_.enqueue(value); }
+    Handle handle(size_t /*worker*/)
+    {
+        return Handle{moodycamel::ProducerToken(queue_), moodycamel::ConsumerToken(queue_)};
+    }
+
+    template<class Iterator>
+    void push_bulk(Handle& handle, Iterator first, size_t const count)
+    {
+        queue_.enqueue_bulk(handle.producer, first, count);
+    }
+
+    template<class Iterator>
+    size_t try_pop_bulk(Handle& handle, Iterator out, size_t const max_count)
+    {
+        return queue_.try_dequeue_bulk(handle.consumer, out, max_count);
+    }
+
+private:
+    moodycamel::ConcurrentQueue<T> queue_;
+};
+
+
+// one WorkStealingDeque per worker: a worker pops from the back of its own deque and only steals a single item from
+// the front of another one when its own deque is empty
+template<class T>
+class WorkStealingWorkQueue
+{
+public:
+    struct Handle
+    {
+        size_t worker;
+    };
+
+    explicit WorkStealingWorkQueue(size_t const num_workers)
+        : deques_(num_workers > 0 ? num_workers : 1)
+    {}
+
+    void   push(T const& value) { deques_.front().push(value); }
+    Handle handle(size_t const worker) { return Handle{worker % deques_.size()}; }
+
+    template<class Iterator>
+    void push_bulk(Handle& handle, Iterator first, size_t const count)
+    {
+        deques_[handle.worker].push_bulk(first, first + count);
+    }
+
+    template<class Iterator>
+    size_t try_pop_bulk(Handle& handle, Iterator out, size_t const max_count)
+    {
+        if(size_t const count = deques_[handle.worker].try_pop_bulk(out, max_count); count > 0)
+            return count;
+
+        for(size_t i = 1; i < deques_.size(); ++i)
+        {
+            if(deques_[(handle.worker + i) % deques_.size()].try_steal(*out))
+                return 1;
+        }
+        return 0;
+    }
+
+private:
+    std::vector<WorkStealingDeque<T>> deques_;
+};
+
+#endif // WORK_QUEUE_H
@@ -0,0 +1,189 @@
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Per-worker Chase-Lev deque (in the C11 formulation of Le et al., "Correct and Efficient Work-Stealing for Weak
+// Memory Models"): the owner pushes and pops at the bottom (depth-first, cache-warm) without locks, thieves take from
+// the top (oldest items, usually the largest amount of remaining work) with a single CAS. Only the last item is
+// contended between the owner and the thieves.
+//
+// push(), push_bulk(), try_pop(), try_pop_bulk() and clear() may only be called by the owning thread, try_steal() by
+// any thread. try_steal() can fail spuriously when it loses a race for the top item, callers retry or look elsewhere.
+//
+// Items are copied in and out word by word through relaxed atomics, so T must be trivially copyable. A thief may read
+// a slot the owner is overwriting, but then its CAS on top fails and the torn copy is discarded. Rings are only
+// replaced by larger ones; the old rings stay alive until the deque is destroyed, as a thief may still read from them.
+template<class T>
+class alignas(64) WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires a trivially copyable item type");
+
+    class Ring
+    {
+    public:
+        explicit Ring(size_t const capacity)
+            : mask_(capacity - 1),
+              words_(new std::atomic<uint64_t>[capacity * words_per_item])
+        {}
+
+        size_t capacity() const { return mask_ + 1; }
+
+        T load(int64_t const idx) const
+        {
+            uint64_t                     buffer[words_per_item];
+            std::atomic<uint64_t> const* slot = words_.get() + (static_cast<size_t>(idx) & mask_) * words_per_item;
+            for(size_t w = 0; w < words_per_item; ++w)
+                buffer[w] = slot[w].load(std::memory_order_relaxed);
+
+            T value;
+            std::memcpy(&value, buffer, sizeof(T));
+            return value;
+        }
+
+        void store(int64_t const idx, T const& value)
+        {
+            uint64_t buffer[words_per_item] = {};
+            std::memcpy(buffer, &value, sizeof(T));
+
+            std::atomic<uint64_t>* slot = words_.get() + (static_cast<size_t>(idx) & mask_) * words_per_item;
+            for(size_t w = 0; w < words_per_item; ++w)
+                slot[w].store(buffer[w], std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr size_t words_per_item = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        size_t                                   mask_;
+        std::unique_ptr<std::atomic<uint64_t>[]> words_;
+    };
+
+public:
+    explicit WorkStealingDeque(size_t const capacity = 256)
+    {
+        rings_.push_back(std::make_unique<Ring>(round_up_capacity(capacity)));
+        ring_.store(rings_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(WorkStealingDeque const&)            = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque const&) = delete;
+
+    void push(T const& value)
+    {
+        int64_t const b    = bottom_.load(std::memory_order_relaxed);
+        int64_t const t    = top_.load(std::memory_order_acquire);
+        Ring*         ring = reserve(b, t, 1);
+
+        ring->store(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // publish all items at once, thieves see either none or all of them
+    template<class Iterator>
+    void push_bulk(Iterator first, Iterator last)
+    {
+        int64_t const b    = bottom_.load(std::memory_order_relaxed);
+        int64_t const t    = top_.load(std::memory_order_acquire);
+        Ring*         ring = reserve(b, t, static_cast<size_t>(std::distance(first, last)));
+
+        int64_t idx = b;
+        for(; first != last; ++first, ++idx)
+            ring->store(idx, *first);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(idx, std::memory_order_relaxed);
+    }
+
+    bool try_pop(T& value)
+    {
+        int64_t const b    = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring*         ring = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if(t > b)
+        {
+            // empty, undo the reservation
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        value = ring->load(b);
+        if(t < b)
+            return true;
+
+        // last item, race the thieves for it
+        bool const won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    // pop up to max_count items from the bottom into out, returns the number of items popped
+    template<class OutputIterator>
+    size_t try_pop_bulk(OutputIterator out, size_t const max_count)
+    {
+        size_t count = 0;
+        for(T value; count < max_count && try_pop(value); ++count, ++out)
+            *out = value;
+        return count;
+    }
+
+    bool try_steal(T& value)
+    {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t const b = bottom_.load(std::memory_order_acquire);
+        if(t >= b)
+            return false;
+
+        T const item = ring_.load(std::memory_order_acquire)->load(t);
+        if(!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return false;
+        value = item;
+        return true;
+    }
+
+    // drop all items, must not run concurrently with try_steal()
+    void clear() { bottom_.store(top_.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<int64_t>   top_{0};
+    alignas(64) std::atomic<int64_t>   bottom_{0};
+    std::atomic<Ring*>                 ring_{nullptr};
+    std::vector<std::unique_ptr<Ring>> rings_; // owner only, every ring ever used
+
+    static size_t round_up_capacity(size_t const capacity)
+    {
+        size_t res = 1;
+        while(res < capacity)
+            res <<= 1;
+        return res;
+    }
+
+    // ring with room for count more items on top of [t, b), copying the live items into a larger ring if needed
+    Ring* reserve(int64_t const b, int64_t const t, size_t const count)
+    {
+        Ring*        ring = ring_.load(std::memory_order_relaxed);
+        size_t const size = static_cast<size_t>(b - t);
+        if(size + count <= ring->capacity())
+            return ring;
+
+        auto grown = std::make_unique<Ring>(round_up_capacity(2 * (size + count)));
+        for(int64_t idx = t; idx < b; ++idx)
+            grown->store(idx, ring->load(idx));
+        ring = grown.get();
+        rings_.push_back(std::move(grown));
+        ring_.store(ring, std::memory_order_release);
+        return ring;
+    }
+};
+
+#endif // WORK_STEALING_DEQUE_H
@@ -0,0 +1,75 @@
+#ifndef CONVEX_TRIANGULATIONS_TESTPOINTSETS_HPP
+#define CONVEX_TRIANGULATIONS_TESTPOINTSETS_HPP
+
+#include "mesh_cell.h"
+#include "vec2.h"
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+
+// Point sets shared by the unit tests, the first two are those of the benchmark.
+namespace test
+{
+    // PointSet1 of the benchmark, lattice points with many collinear and cocircular subsets
+    inline std::shared_ptr<std::vector<Vec2> const> point_set_1(size_t n)
+    {
+        std::vector<Vec2> const pts = {{0, 0}, {0, 1}, {1, 0}, {1, 1}, {0, 2}, {1, 2}, {2, 0}, {2, 1}, {2, 2}, {0, 3},
+                                       {1, 3}, {2, 3}, {3, 0}, {3, 1}, {3, 2}, {3, 3}, {1, 4}, {2, 4}, {3, 4}};
+        return std::make_shared<std::vector<Vec2> const>(pts.begin(), pts.begin() + n);
+    }
+
+    // PointSet2 of the benchmark, points in general position
+    inline std::shared_ptr<std::vector<Vec2> const> point_set_2(size_t n)
+    {
+        std::vector<Vec2> const pts = {{1, 1},   {0, 3},  {2, 0},   {-5, -1}, {-1, -5}, {4, 5},
+                                       {-6, -4}, {2, -2}, {-3, -1}, {2, -5},  {-5, 1},  {-1, 1},
+                                       {-2, -2}, {3, -2}, {-2, 2},  {-3, -3}, {1, -2},  {5, -2}};
+        return std::make_shared<std::vector<Vec2> const>(pts.begin(), pts.begin() + n);
+    }
+
+    // points (i % width, i / width)
+    inline std::shared_ptr<std::vector<Vec2> const> lattice(size_t n, size_t width)
+    {
+        auto pts = std::make_shared<std::vector<Vec2>>();
+        for(size_t i = 0; i < n; ++i)
+            pts->emplace_back(static_cast<Vec2::float_type>(i % width), static_cast<Vec2::float_type>(i / width));
+        return pts;
+    }
+
+    // integer points in [-1000, 1000]^2, nearly collinear triples are common at this density
+    inline std::shared_ptr<std::vector<Vec2> const> random_points(size_t n, unsigned seed)
+    {
+        std::mt19937                       rng(seed);
+        std::uniform_int_distribution<int> coord(-1000, 1000);
+        auto                               pts = std::make_shared<std::vector<Vec2>>();
+        for(size_t i = 0; i < n; ++i)
+            pts->emplace_back(coord(rng), coord(rng));
+        return pts;
+    }
+
+    template<class Range>
+    std::set<std::pair<size_t, size_t>> edge_set(Range const& edges)
+    {
+        std::set<std::pair<size_t, size_t>> res;
+        for(EdgeCell const edge: edges)
+            res.emplace(edge.a, edge.b);
+        return res;
+    }
+
+    // uniformly chosen flippable edge of mesh, which must have one
+    template<class Mesh>
+    EdgeCell random_flippable(Mesh const& mesh, std::mt19937& rng)
+    {
+        auto const flippable = edge_set(mesh.flippable());
+        auto       it        = flippable.begin();
+        std::advance(it, rng() % flippable.size());
+        return EdgeCell(it->first, it->second);
+    }
+} // namespace test
+
+#endif // CONVEX_TRIANGULATIONS_TESTPOINTSETS_HPP
@@ -0,0 +1,80 @@
+#include "mesh_triangulation_2d_bitset.h"
+#include "test_point_sets.h"
+#include "triangulation_flip_graph.h"
+#include "utils/arena.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+
+namespace
+{
+    struct Counted
+    {
+        explicit Counted(int& live)
+            : live_(live)
+        {
+            ++live_;
+        }
+        ~Counted() { --live_; }
+
+        int& live_;
+    };
+} // namespace
+
+
+TEST(Arena, CreateAndDestroyAcrossBlocks)
+{
+    int                   live = 0;
+    Arena<Counted>        arena(4);
+    std::vector<Counted*> created;
+    for(int i = 0; i < 10; ++i)
+        created.push_back(arena.create(live));
+    EXPECT_EQ(arena.size(), 10u);
+    EXPECT_EQ(live, 10);
+
+    // destroy_last walks back over the block boundary between the 5th and the 4th object
+    for(int i = 0; i < 6; ++i)
+        arena.destroy_last();
+    EXPECT_EQ(arena.size(), 4u);
+    EXPECT_EQ(live, 4);
+
+    // the freed slots are handed out again in the same order
+    for(size_t i = 4; i < 10; ++i)
+        EXPECT_EQ(arena.create(live), created[i]);
+    EXPECT_EQ(live, 10);
+
+    arena.clear();
+    EXPECT_TRUE(arena.empty());
+    EXPECT_EQ(live, 0);
+}
+
+
+TEST(Arena, ClearKeepsTheBlocks)
+{
+    int                   live = 0;
+    Arena<Counted>        arena(4);
+    std::vector<Counted*> created;
+    for(int i = 0; i < 9; ++i)
+        created.push_back(arena.create(live));
+
+    arena.clear();
+    for(int i = 0; i < 9; ++i)
+        EXPECT_EQ(arena.create(live), created[i]);
+    EXPECT_EQ(live, 9);
+
+    arena.release();
+    EXPECT_EQ(live, 0);
+}
+
+
+TEST(Arena, RegeneratedGraphReusesTheStorage)
+{
+    TriangulationFlipGraph<MeshTriangulation2DBitset<16>> graph(test::lattice(12, 4));
+    for(int run = 0; run < 2; ++run)
+    {
+        graph.generate_graph();
+        EXPECT_EQ(graph.nodes().size(), 852u);
+    }
+}
@@ -0,0 +1,107 @@
+#include "mesh_triangulation_2d.h"
+#include "mesh_triangulation_2d_bitset.h"
+#include "test_point_sets.h"
+#include "triangulation_flip_graph.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+
+namespace
+{
+    // every node keeps its triangulation, every edge is stored once per direction and joins two triangulations one
+    // flip apart
+    template<class Mesh>
+    void check_csr(FlipGraphCSR<Mesh> const& csr)
+    {
+        ASSERT_EQ(csr.offsets.size(), csr.num_nodes() + 1);
+        ASSERT_TRUE(std::is_sorted(csr.nodes.begin(), csr.nodes.end()));
+        for(typename FlipGraphCSR<Mesh>::node_id id = 0; id < csr.num_nodes(); ++id)
+        {
+            ASSERT_EQ(csr.id_of(csr.nodes[id]), id);
+            ASSERT_EQ(csr.degree(id), csr.nodes[id]->flippable().size());
+
+            auto const adjacent = csr.adjacent(id);
+            ASSERT_TRUE(std::is_sorted(adjacent.begin(), adjacent.end()));
+            for(auto const other: adjacent)
+            {
+                ASSERT_NE(other, id);
+                auto const back = csr.adjacent(other);
+                ASSERT_TRUE(std::binary_search(back.begin(), back.end(), id));
+            }
+        }
+        EXPECT_EQ(csr.id_of(nullptr), csr.num_nodes());
+    }
+} // namespace
+
+
+TEST(FlipGraphCSR, SequentialEngine)
+{
+    TriangulationFlipGraph<MeshTriangulation2DBitset<16>> graph(test::point_set_2(12));
+    graph.generate_graph();
+    EXPECT_EQ(graph.edges().size(), 18936u);
+
+    auto const csr = graph.finalize_csr();
+    EXPECT_EQ(csr.num_nodes(), 4719u);
+    EXPECT_EQ(csr.num_edges(), 18936u);
+    EXPECT_TRUE(graph.edges().empty());
+    check_csr(csr);
+}
+
+
+TEST(FlipGraphCSR, ConcurrentEngines)
+{
+    ConcurrentTriangulationFlipGraph<MeshTriangulation2D<>> concurrent(test::lattice(12, 4));
+    concurrent.generate_graph(4);
+    auto const concurrent_csr = concurrent.finalize_csr();
+    EXPECT_EQ(concurrent_csr.num_nodes(), 852u);
+    EXPECT_EQ(concurrent_csr.num_edges(), 2626u);
+    check_csr(concurrent_csr);
+
+    WorkStealingTriangulationFlipGraph<MeshTriangulation2DBitset<16>> work_stealing(test::point_set_2(12));
+    work_stealing.generate_graph(4);
+    auto const work_stealing_csr = work_stealing.finalize_csr();
+    EXPECT_EQ(work_stealing_csr.num_nodes(), 4719u);
+    EXPECT_EQ(work_stealing_csr.num_edges(), 18936u);
+    check_csr(work_stealing_csr);
+
+    ConcurrentNodeTriangulationFlipGraph<MeshTriangulation2DBitset<16>> node(test::point_set_2(12));
+    node.generate_graph(4);
+    auto const node_csr = node.finalize_csr();
+    EXPECT_EQ(node_csr.num_nodes(), 4719u);
+    EXPECT_EQ(node_csr.num_edges(), 18936u);
+    check_csr(node_csr);
+}
+
+
+TEST(FlipGraphCSR, CanonicalOwnerRecordsEveryEdgeOnce)
+{
+    auto const pts = test::point_set_2(12);
+
+    TriangulationFlipGraph<MeshTriangulation2DBitset<16>> sequential(pts, FlipGraphEdgeMode::CanonicalOwner);
+    sequential.generate_graph();
+    EXPECT_TRUE(sequential.edges().empty());
+    EXPECT_EQ(sequential.num_edges(), 18936u);
+    auto const sequential_csr = sequential.finalize_csr();
+    EXPECT_EQ(sequential_csr.num_edges(), 18936u);
+    check_csr(sequential_csr);
+
+    ConcurrentTriangulationFlipGraph<MeshTriangulation2DBitset<16>> concurrent(pts, FlipGraphEdgeMode::CanonicalOwner);
+    concurrent.generate_graph(4);
+    EXPECT_TRUE(concurrent.edges().empty());
+    EXPECT_EQ(concurrent.num_edges(), 18936u);
+    check_csr(concurrent.finalize_csr());
+
+    WorkStealingTriangulationFlipGraph<MeshTriangulation2DBitset<16>> work_stealing(pts,
+                                                                                    FlipGraphEdgeMode::CanonicalOwner);
+    work_stealing.generate_graph(4);
+    EXPECT_EQ(work_stealing.num_edges(), 18936u);
+    check_csr(work_stealing.finalize_csr());
+
+    ConcurrentNodeTriangulationFlipGraph<MeshTriangulation2D<>> node(test::lattice(12, 4),
+                                                                     FlipGraphEdgeMode::CanonicalOwner);
+    node.generate_graph(4);
+    EXPECT_EQ(node.num_edges(), 2626u);
+    check_csr(node.finalize_csr());
+}
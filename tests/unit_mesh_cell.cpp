@@ -0,0 +1,107 @@
+#include "mesh_cell.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <type_traits>
+
+
+static_assert(std::is_convertible_v<BasicEdgeCell<uint16_t>, EdgeCell>, "widening must be implicit");
+static_assert(!std::is_convertible_v<EdgeCell, BasicEdgeCell<uint16_t>>, "narrowing must be explicit");
+static_assert(std::is_constructible_v<BasicEdgeCell<uint16_t>, EdgeCell>, "narrowing must be possible");
+static_assert(sizeof(BasicEdgeCell<uint8_t>) == 2 && sizeof(BasicTriangleCell<uint16_t>) == 6);
+
+
+TEST(BasicEdgeCell, NarrowAndWiden)
+{
+    EdgeCell const                edge(300, 7);
+    BasicEdgeCell<uint16_t> const narrow(edge);
+    EXPECT_EQ(narrow.a, 7u);
+    EXPECT_EQ(narrow.b, 300u);
+    EXPECT_EQ(narrow.index(), edge.index());
+    EXPECT_EQ(EdgeCell(narrow), edge);
+}
+
+
+TEST(BasicEdgeCell, UndefinedMapsToTheSentinel)
+{
+    BasicEdgeCell<uint8_t> const undefined{};
+    EXPECT_TRUE(undefined.undefined());
+    EXPECT_EQ(undefined.b, 255u);
+
+    // the undefined vertex of a border edge survives narrowing and widening
+    BasicEdgeCell<uint8_t> const border(EdgeCell(3, -1ull));
+    EXPECT_TRUE(border.undefined());
+    EXPECT_EQ(border.a, 3u);
+    EXPECT_EQ(EdgeCell(border), EdgeCell(3, -1ull));
+
+    BasicEdgeCell<uint16_t> const wider(border);
+    EXPECT_EQ(wider.b, BasicEdgeCell<uint16_t>::undefined_index);
+}
+
+
+TEST(BasicEdgeCell, IndexDoesNotOverflowNarrowTypes)
+{
+    BasicEdgeCell<uint8_t> const edge(253, 254);
+    EXPECT_EQ(edge.index(), EdgeCell(253, 254).index());
+    EXPECT_EQ(edge.index(), 254u * 253u / 2 + 253u);
+}
+
+
+TEST(BasicEdgeCell, OrderingFollowsTheSmallerVertexFirst)
+{
+    EXPECT_TRUE(EdgeCell(1, 5) < EdgeCell(2, 3));
+    EXPECT_FALSE(EdgeCell(2, 3) < EdgeCell(1, 5));
+    EXPECT_TRUE(EdgeCell(1, 3) < EdgeCell(1, 5));
+    EXPECT_FALSE(EdgeCell(1, 5) < EdgeCell(1, 5));
+}
+
+
+TEST(EdgeKey, Canonicalization)
+{
+    EXPECT_EQ(EdgeKey(3, 9), EdgeKey(9, 3));
+    EXPECT_EQ(EdgeKey(9, 3).a(), 3u);
+    EXPECT_EQ(EdgeKey(9, 3).b(), 9u);
+    EXPECT_EQ(EdgeKey(9, 3).value(), (9u << 16) | 3u);
+    EXPECT_EQ(EdgeCell(EdgeKey(9, 3)), EdgeCell(3, 9));
+    EXPECT_EQ(EdgeKey(EdgeCell(3, 9)), EdgeKey(3, 9));
+    EXPECT_EQ(EdgeKey(BasicEdgeCell<uint16_t>(3, 9)), EdgeKey(3, 9));
+}
+
+
+TEST(EdgeKey, Undefined)
+{
+    EXPECT_TRUE(EdgeKey().undefined());
+    EXPECT_TRUE(EdgeKey(4, -1ull).undefined());
+    EXPECT_EQ(EdgeKey(4, -1ull).a(), 4u);
+    EXPECT_EQ(EdgeCell(EdgeKey(4, -1ull)), EdgeCell(4, -1ull));
+    EXPECT_TRUE(EdgeKey(BasicEdgeCell<uint8_t>()).undefined());
+    EXPECT_FALSE(EdgeKey(0, 1).undefined());
+}
+
+
+TEST(EdgeKey, OrderingIsTheIndexOrder)
+{
+    for(size_t b = 1; b < 40; ++b)
+    {
+        for(size_t a = 0; a < b; ++a)
+        {
+            EdgeKey const key(b, a);
+            EXPECT_EQ(key.index(), EdgeCell(a, b).index());
+            EdgeKey const next = a + 1 < b ? EdgeKey(a + 1, b) : EdgeKey(0, b + 1);
+            EXPECT_TRUE(key < next);
+            EXPECT_EQ(next.index(), key.index() + 1);
+        }
+    }
+}
+
+
+TEST(BasicTriangleCell, OppositePoint)
+{
+    BasicTriangleCell<uint16_t> const triangle(2, 4, 9);
+    EXPECT_EQ(triangle.opposite_point(BasicEdgeCell<uint16_t>(9, 4)), 2u);
+    EXPECT_EQ(triangle.opposite_point(BasicEdgeCell<uint16_t>(2, 9)), 4u);
+    EXPECT_EQ(triangle.opposite_point(BasicEdgeCell<uint16_t>(1, 9)), -1ull);
+    EXPECT_FALSE(triangle.undefined());
+    EXPECT_TRUE(BasicTriangleCell<uint16_t>().undefined());
+}
@@ -0,0 +1,138 @@
+#include "mesh_triangulation_2d.h"
+#include "test_point_sets.h"
+#include "triangulation_flip_graph.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+    // flip the same random edges on mesh and on the default mesh, both must agree on every edge at every step, and
+    // mesh must generate the same flip graph
+    template<class Mesh>
+    void check_matches_default_mesh()
+    {
+        for(auto const& pts: {test::point_set_2(18), test::lattice(42, 7), test::random_points(40, 3)})
+        {
+            Mesh                  mesh(pts);
+            MeshTriangulation2D<> reference(pts);
+            ASSERT_EQ(mesh.triangulate(), Mesh::Result::Success);
+            ASSERT_EQ(reference.triangulate(), MeshTriangulation2D<>::Result::Success);
+
+            std::mt19937 rng(1);
+            for(size_t step = 0; step < 300 && !reference.flippable().empty(); ++step)
+            {
+                ASSERT_EQ(mesh.edge_adjacency().size(), reference.edge_adjacency().size());
+                for(auto const& [edge, opposite]: reference.edge_adjacency())
+                    ASSERT_EQ(mesh.opposite_edge(edge), opposite) << "step " << step;
+                ASSERT_EQ(mesh.fingerprint(), reference.fingerprint());
+
+                EdgeCell const edge = test::random_flippable(reference, rng);
+                ASSERT_EQ(mesh.flip_edge(edge), Mesh::Result::Success);
+                ASSERT_EQ(reference.flip_edge(edge), MeshTriangulation2D<>::Result::Success);
+            }
+        }
+
+        TriangulationFlipGraph<Mesh> graph(test::point_set_2(12));
+        graph.generate_graph();
+        EXPECT_EQ(graph.nodes().size(), 4719u);
+        EXPECT_EQ(graph.edges().size(), 18936u);
+    }
+} // namespace
+
+
+TEST(MeshTriangulation2D, CanonicalKeyMatchesEdgeSet)
+{
+    MeshTriangulation2D<> mesh(test::lattice(42, 7));
+    ASSERT_EQ(mesh.triangulate(), MeshTriangulation2D<>::Result::Success);
+
+    std::mt19937 rng(1);
+    for(size_t step = 0; step < 300 && !mesh.flippable().empty(); ++step)
+    {
+        std::vector<uint64_t> expected_key(mesh.canonical_key().size(), 0);
+        Fingerprint128        expected{};
+        for(auto const& [edge, opposite]: mesh.edge_adjacency())
+        {
+            expected_key[edge.index() / 64] |= uint64_t{1} << (edge.index() % 64);
+            expected += HashUtils::unordered_element128(edge.index());
+        }
+        ASSERT_EQ(mesh.canonical_key(), expected_key);
+        ASSERT_EQ(mesh.fingerprint(), expected);
+        ASSERT_EQ(mesh.flip_edge(test::random_flippable(mesh, rng)), MeshTriangulation2D<>::Result::Success);
+    }
+}
+
+
+TEST(MeshTriangulation2D, FingerprintRestoredByFlippingBack)
+{
+    MeshTriangulation2D<> mesh(test::point_set_1(19));
+    ASSERT_EQ(mesh.triangulate(), MeshTriangulation2D<>::Result::Success);
+    MeshTriangulation2D<> const start = mesh;
+
+    // flipping the new diagonals in reverse order walks back to the start
+    std::mt19937          rng(2);
+    std::vector<EdgeCell> diagonals;
+    for(size_t step = 0; step < 50; ++step)
+    {
+        EdgeCell const edge = test::random_flippable(mesh, rng);
+        diagonals.push_back(mesh.edge_adjacency().at(edge));
+        ASSERT_EQ(mesh.flip_edge(edge), MeshTriangulation2D<>::Result::Success);
+    }
+    EXPECT_NE(mesh.fingerprint(), start.fingerprint());
+
+    for(auto it = diagonals.rbegin(); it != diagonals.rend(); ++it)
+        ASSERT_EQ(mesh.flip_edge(*it), MeshTriangulation2D<>::Result::Success);
+    EXPECT_EQ(mesh.fingerprint(), start.fingerprint());
+    EXPECT_TRUE(mesh == start);
+}
+
+
+TEST(MeshTriangulation2D, OppositeEdge)
+{
+    MeshTriangulation2D<> mesh(test::point_set_1(19));
+    ASSERT_EQ(mesh.triangulate(), MeshTriangulation2D<>::Result::Success);
+
+    for(auto const& [edge, opposite]: mesh.edge_adjacency())
+        EXPECT_EQ(mesh.opposite_edge(edge), opposite);
+    EXPECT_TRUE(mesh.opposite_edge(EdgeCell(0, 18)).undefined());
+}
+
+
+TEST(MeshTriangulation2D, FlipGraphNodeCountWithCollinearPoints)
+{
+    // lattices have distinct triangulations with the same flippable edges, only the full edge set tells them apart
+    TriangulationFlipGraph<MeshTriangulation2D<>> graph(test::lattice(12, 4));
+    graph.generate_graph();
+    EXPECT_EQ(graph.nodes().size(), 852u);
+    EXPECT_EQ(graph.edges().size(), 2626u);
+}
+
+
+TEST(MeshTriangulation2D, FlipGraphNodeCountInGeneralPosition)
+{
+    // nearly collinear triples used to be misclassified by the epsilon test and cut off part of the graph
+    TriangulationFlipGraph<MeshTriangulation2D<>> graph(test::point_set_2(12));
+    graph.generate_graph();
+    EXPECT_EQ(graph.nodes().size(), 4719u);
+    EXPECT_EQ(graph.edges().size(), 18936u);
+}
+
+
+
+TEST(MeshTriangulation2D, CompactIndicesMatchDefaultMesh)
+{
+    check_matches_default_mesh<
+        MeshTriangulation2D<MeshTriangulationCompactTraits<MeshTriangulationDefaultTraits, uint8_t>>>();
+}
+
+
+TEST(MeshTriangulation2D, PackedKeysMatchDefaultMesh)
+{
+    check_matches_default_mesh<MeshTriangulation2D<MeshTriangulationPackedTraits<MeshTriangulationDefaultTraits>>>();
+    check_matches_default_mesh<MeshTriangulation2D<MeshTriangulationPackedTraits<MeshTriangulationAbslTraits>>>();
+}
@@ -0,0 +1,113 @@
+#include "mesh_triangulation_2d.h"
+#include "mesh_triangulation_2d_bitset.h"
+#include "test_point_sets.h"
+#include "triangulation_flip_graph.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+
+namespace
+{
+    // flip the same random edges on the bitset and the hash-map mesh, both must agree on every edge at every step
+    void check_random_walk(std::shared_ptr<std::vector<Vec2> const> const& pts, unsigned seed, size_t num_steps)
+    {
+        MeshTriangulation2DBitset<64> mesh(pts);
+        MeshTriangulation2D<>         reference(pts);
+        ASSERT_EQ(mesh.triangulate(), MeshTriangulation2D<>::Result::Success);
+        ASSERT_EQ(reference.triangulate(), MeshTriangulation2D<>::Result::Success);
+
+        std::mt19937 rng(seed);
+        for(size_t step = 0; step < num_steps; ++step)
+        {
+            std::set<std::pair<size_t, size_t>> reference_edges;
+            for(auto const& [edge, opposite]: reference.edge_adjacency())
+            {
+                reference_edges.emplace(edge.a, edge.b);
+                ASSERT_TRUE(mesh.contains(edge));
+                ASSERT_EQ(mesh.opposite_edge(edge), opposite) << "step " << step;
+            }
+            ASSERT_EQ(test::edge_set(mesh.edges()), reference_edges);
+            ASSERT_EQ(test::edge_set(mesh.flippable()), test::edge_set(reference.flippable()));
+            ASSERT_EQ(mesh.fingerprint(), reference.fingerprint());
+
+            if(mesh.flippable().empty())
+                break;
+            EdgeCell const edge = test::random_flippable(mesh, rng);
+            ASSERT_EQ(mesh.flip_edge(edge), MeshTriangulation2D<>::Result::Success);
+            ASSERT_EQ(reference.flip_edge(edge), MeshTriangulation2D<>::Result::Success);
+        }
+    }
+} // namespace
+
+
+TEST(MeshTriangulation2DBitset, RandomWalkMatchesHashMapMesh)
+{
+    for(unsigned seed = 1; seed <= 4; ++seed)
+    {
+        check_random_walk(test::point_set_1(19), seed, 300);
+        check_random_walk(test::point_set_2(18), seed, 300);
+        check_random_walk(test::lattice(42, 7), seed, 300);
+        check_random_walk(test::random_points(40, seed), seed, 300);
+    }
+}
+
+
+TEST(MeshTriangulation2DBitset, EdgeIndexRoundTrip)
+{
+    using Mesh = MeshTriangulation2DBitset<32>;
+    for(size_t idx = 0; idx < Mesh::max_edges; ++idx)
+        ASSERT_EQ(Mesh::edge_index(Mesh::edge_from_index(idx)), idx);
+    EXPECT_EQ(Mesh::edge_from_index(0), EdgeCell(0, 1));
+    EXPECT_EQ(Mesh::edge_from_index(Mesh::max_edges - 1), EdgeCell(30, 31));
+}
+
+
+TEST(MeshTriangulation2DBitset, FingerprintMatchesRecomputedHash)
+{
+    MeshTriangulation2DBitset<64> mesh(test::lattice(42, 7));
+    ASSERT_EQ(mesh.triangulate(), MeshTriangulation2D<>::Result::Success);
+
+    std::mt19937 rng(1);
+    for(size_t step = 0; step < 300 && !mesh.flippable().empty(); ++step)
+    {
+        Fingerprint128 expected{};
+        for(EdgeCell const edge: mesh.edges())
+            expected += HashUtils::unordered_element128(mesh.edge_index(edge));
+        ASSERT_EQ(mesh.fingerprint(), expected);
+
+        EdgeCell const edge     = test::random_flippable(mesh, rng);
+        EdgeCell const diagonal = mesh.opposite_edge(edge);
+        ASSERT_EQ(mesh.flip_edge(edge), MeshTriangulation2D<>::Result::Success);
+
+        // flipping the new diagonal restores the previous triangulation and its fingerprint
+        auto const flipped = mesh;
+        ASSERT_EQ(mesh.flip_edge(diagonal), MeshTriangulation2D<>::Result::Success);
+        ASSERT_EQ(mesh.fingerprint(), expected);
+        mesh = flipped;
+    }
+}
+
+
+TEST(MeshTriangulation2DBitset, FlipFailures)
+{
+    MeshTriangulation2DBitset<16> mesh(test::lattice(9, 3));
+    ASSERT_EQ(mesh.triangulate(), MeshTriangulation2D<>::Result::Success);
+
+    // the bottom row of the lattice lies on the convex hull, its edges are in every triangulation
+    EXPECT_EQ(mesh.flip_edge(EdgeCell(0, 1)), MeshTriangulation2D<>::Result::FailedFlipBorderEdge);
+    EXPECT_EQ(mesh.flip_edge(EdgeCell(0, 8)), MeshTriangulation2D<>::Result::FailedEdgeNotFound);
+
+    MeshTriangulation2DBitset<16> too_small(test::lattice(17, 5));
+    EXPECT_EQ(too_small.triangulate(), MeshTriangulation2D<>::Result::FailedTooManyPoints);
+}
+
+
+TEST(MeshTriangulation2DBitset, FlipGraphNodeCount)
+{
+    TriangulationFlipGraph<MeshTriangulation2DBitset<16>> graph(test::point_set_2(12));
+    graph.generate_graph();
+    EXPECT_EQ(graph.nodes().size(), 4719u);
+    EXPECT_EQ(graph.edges().size(), 18936u);
+}
@@ -0,0 +1,85 @@
+#include "mesh_triangulation_2d.h"
+#include "mesh_triangulation_2d_fixed.h"
+#include "test_point_sets.h"
+#include "triangulation_flip_graph.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+
+namespace
+{
+    // flip the same random edges on the fixed and the hash-map mesh, both must agree on every edge at every step
+    void check_random_walk(std::shared_ptr<std::vector<Vec2> const> const& pts, unsigned seed, size_t num_steps)
+    {
+        auto const geometry = std::make_shared<PointSetGeometry const>(pts);
+
+        MeshTriangulation2DFixed<64> mesh(geometry);
+        MeshTriangulation2D<>        reference(geometry);
+        ASSERT_EQ(mesh.triangulate(), MeshTriangulation2D<>::Result::Success);
+        ASSERT_EQ(reference.triangulate(), MeshTriangulation2D<>::Result::Success);
+
+        std::mt19937 rng(seed);
+        for(size_t step = 0; step < num_steps; ++step)
+        {
+            for(auto const& [edge, opposite]: reference.edge_adjacency())
+            {
+                ASSERT_TRUE(mesh.contains(edge));
+                ASSERT_EQ(mesh.opposite_edge(edge), opposite) << "step " << step;
+            }
+            ASSERT_EQ(test::edge_set(mesh.edges()).size(), reference.edge_adjacency().size());
+            ASSERT_EQ(test::edge_set(mesh.flippable()), test::edge_set(reference.flippable()));
+            ASSERT_EQ(mesh.fingerprint(), reference.fingerprint());
+
+            if(mesh.flippable().empty())
+                break;
+            EdgeCell const edge = test::random_flippable(mesh, rng);
+            ASSERT_EQ(mesh.flip_edge(edge), MeshTriangulation2D<>::Result::Success);
+            ASSERT_EQ(reference.flip_edge(edge), MeshTriangulation2D<>::Result::Success);
+        }
+    }
+} // namespace
+
+
+TEST(MeshTriangulation2DFixed, RandomWalkMatchesHashMapMesh)
+{
+    for(unsigned seed = 1; seed <= 4; ++seed)
+    {
+        check_random_walk(test::point_set_2(18), seed, 300);
+        check_random_walk(test::lattice(42, 7), seed, 300);
+        check_random_walk(test::random_points(40, seed), seed, 300);
+    }
+}
+
+
+TEST(MeshTriangulation2DFixed, FlipFailures)
+{
+    auto const                   geometry = std::make_shared<PointSetGeometry const>(test::lattice(9, 3));
+    MeshTriangulation2DFixed<16> mesh(geometry);
+    ASSERT_EQ(mesh.triangulate(), MeshTriangulation2D<>::Result::Success);
+
+    // the bottom row of the lattice lies on the convex hull, its edges are in every triangulation
+    EXPECT_EQ(mesh.flip_edge(EdgeCell(0, 1)), MeshTriangulation2D<>::Result::FailedFlipBorderEdge);
+    EXPECT_EQ(mesh.flip_edge(EdgeCell(0, 8)), MeshTriangulation2D<>::Result::FailedEdgeNotFound);
+    EXPECT_TRUE(mesh.opposite_edge(EdgeCell(0, 8)).undefined());
+
+    auto const                   large = std::make_shared<PointSetGeometry const>(test::lattice(17, 5));
+    MeshTriangulation2DFixed<16> too_small(large);
+    EXPECT_EQ(too_small.triangulate(), MeshTriangulation2D<>::Result::FailedTooManyPoints);
+}
+
+
+TEST(MeshTriangulation2DFixed, FlipGraphCounts)
+{
+    TriangulationFlipGraph<MeshTriangulation2DFixed<16>> graph(test::point_set_2(12));
+    graph.generate_graph();
+    EXPECT_EQ(graph.nodes().size(), 4719u);
+    EXPECT_EQ(graph.num_edges(), 18936u);
+
+    ConcurrentTriangulationFlipGraph<MeshTriangulation2DFixed<16>> lattice(test::lattice(12, 4));
+    lattice.generate_graph(4);
+    EXPECT_EQ(lattice.nodes().size(), 852u);
+    EXPECT_EQ(lattice.num_edges(), 2626u);
+}
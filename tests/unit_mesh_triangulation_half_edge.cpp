@@ -0,0 +1,92 @@
+#include "mesh_triangulation_2d.h"
+#include "mesh_triangulation_2d_half_edge.h"
+#include "test_point_sets.h"
+#include "triangulation_flip_graph.h"
+#include "triangulation_reverse_search.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+
+namespace
+{
+    // flip the same random edges on the half-edge and the hash-map mesh, both must agree on every edge at every step
+    void check_random_walk(std::shared_ptr<std::vector<Vec2> const> const& pts, unsigned seed, size_t num_steps)
+    {
+        auto const geometry = std::make_shared<PointSetGeometry const>(pts);
+
+        MeshTriangulation2DHalfEdge mesh(geometry);
+        MeshTriangulation2D<>       reference(geometry);
+        ASSERT_EQ(mesh.triangulate(), MeshTriangulation2D<>::Result::Success);
+        ASSERT_EQ(reference.triangulate(), MeshTriangulation2D<>::Result::Success);
+
+        std::mt19937 rng(seed);
+        for(size_t step = 0; step < num_steps; ++step)
+        {
+            // border edges included, their outer vertex is undefined in both meshes
+            for(auto const& [edge, opposite]: reference.edge_adjacency())
+            {
+                ASSERT_TRUE(mesh.contains(edge));
+                ASSERT_EQ(mesh.opposite_edge(edge), opposite) << "step " << step;
+            }
+            ASSERT_EQ(test::edge_set(mesh.flippable()), test::edge_set(reference.flippable()));
+            ASSERT_EQ(mesh.canonical_key(), reference.canonical_key());
+            ASSERT_EQ(mesh.fingerprint(), reference.fingerprint());
+
+            if(mesh.flippable().empty())
+                break;
+            EdgeCell const edge = test::random_flippable(mesh, rng);
+            ASSERT_EQ(mesh.flip_edge(edge), MeshTriangulation2D<>::Result::Success);
+            ASSERT_EQ(reference.flip_edge(edge), MeshTriangulation2D<>::Result::Success);
+        }
+    }
+} // namespace
+
+
+TEST(MeshTriangulation2DHalfEdge, RandomWalkMatchesHashMapMesh)
+{
+    for(unsigned seed = 1; seed <= 4; ++seed)
+    {
+        check_random_walk(test::point_set_2(18), seed, 300);
+        check_random_walk(test::lattice(42, 7), seed, 300);
+        check_random_walk(test::random_points(150, seed), seed, 500);
+    }
+}
+
+
+TEST(MeshTriangulation2DHalfEdge, FlipFailures)
+{
+    MeshTriangulation2DHalfEdge mesh(test::lattice(9, 3));
+    ASSERT_EQ(mesh.triangulate(), MeshTriangulation2D<>::Result::Success);
+
+    // the bottom row of the lattice lies on the convex hull, its edges are in every triangulation
+    EXPECT_EQ(mesh.flip_edge(EdgeCell(0, 1)), MeshTriangulation2D<>::Result::FailedFlipBorderEdge);
+    EXPECT_EQ(mesh.flip_edge(EdgeCell(0, 8)), MeshTriangulation2D<>::Result::FailedEdgeNotFound);
+    EXPECT_TRUE(mesh.opposite_edge(EdgeCell(0, 8)).undefined());
+
+    // a border edge has the apex of its only triangle and the undefined vertex on the outer side
+    EdgeCell const border = mesh.opposite_edge(EdgeCell(0, 1));
+    EXPECT_TRUE(border.undefined());
+    EXPECT_TRUE(border.a == 3 || border.a == 4);
+}
+
+
+TEST(MeshTriangulation2DHalfEdge, FlipGraphCounts)
+{
+    TriangulationFlipGraph<MeshTriangulation2DHalfEdge> graph(test::point_set_2(12));
+    graph.generate_graph();
+    EXPECT_EQ(graph.nodes().size(), 4719u);
+    EXPECT_EQ(graph.num_edges(), 18936u);
+
+    ConcurrentNodeTriangulationFlipGraph<MeshTriangulation2DHalfEdge> node(test::point_set_2(12),
+                                                                           FlipGraphEdgeMode::CanonicalOwner);
+    node.generate_graph(4);
+    EXPECT_EQ(node.nodes().size(), 4719u);
+    EXPECT_EQ(node.num_edges(), 18936u);
+
+    ParallelReverseSearchTriangulationEnumerator<MeshTriangulation2DHalfEdge> parallel(test::lattice(14, 4));
+    parallel.enumerate(4, 64);
+    EXPECT_EQ(parallel.num_nodes(), 6672u);
+    EXPECT_EQ(parallel.num_edges(), 26172u);
+}
@@ -0,0 +1,109 @@
+#include "orient2d.h"
+#include "point_set_geometry.h"
+#include "test_point_sets.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+
+TEST(Orient2D, IntegralCoordinates)
+{
+    EXPECT_TRUE(has_integral_coordinates(*test::point_set_2(18)));
+    EXPECT_TRUE(has_integral_coordinates({Vec2(max_exact_coordinate, -max_exact_coordinate)}));
+    EXPECT_FALSE(has_integral_coordinates({Vec2(0, 0), Vec2(0.5, 1)}));
+    EXPECT_FALSE(has_integral_coordinates({Vec2(2 * max_exact_coordinate, 0)}));
+}
+
+
+TEST(Orient2D, ExactOnNearlyCollinearTriples)
+{
+    // consecutive Fibonacci numbers: (F42, F41) x (F41, F40) = -1, while both products round to the same double
+    Vec2 const o(0, 0);
+    Vec2 const p(267914296, 165580141);
+    Vec2 const q(165580141, 102334155);
+    EXPECT_EQ(orient2d_exact(o, p, q), -1);
+    EXPECT_EQ(orient2d_exact(o, q, p), 1);
+    EXPECT_EQ(orient2d_inexact(o, p, q), 0);
+
+    EXPECT_EQ(orient2d_exact(Vec2(0, 0), Vec2(1, 1), Vec2(3, 3)), 0);
+    EXPECT_EQ(orient2d_exact(Vec2(0, 0), Vec2(1, 0), Vec2(0, 1)), 1);
+    EXPECT_EQ(orient2d_inexact(Vec2(0, 0), Vec2(1, 0), Vec2(0, 1)), 1);
+}
+
+
+TEST(Orient2D, StrictlyConvexQuadrilateral)
+{
+    std::vector<Vec2> const coords = {{0, 0}, {2, 0}, {2, 2}, {0, 2}, {1, 1}, {3, 3}};
+    for(bool const exact: {true, false})
+    {
+        EXPECT_TRUE(is_strictly_convex_quadrilateral(coords, EdgeCell(0, 2), EdgeCell(1, 3), exact));
+        // the centre of the square lies on the edge itself
+        EXPECT_FALSE(is_strictly_convex_quadrilateral(coords, EdgeCell(1, 3), EdgeCell(0, 4), exact));
+        // both opposite vertices lie on the same side of the edge
+        EXPECT_FALSE(is_strictly_convex_quadrilateral(coords, EdgeCell(1, 3), EdgeCell(2, 5), exact));
+    }
+}
+
+
+TEST(Orient2D, InexactQuadrilateralKeepsTheAreaTolerance)
+{
+    // the triangle 0, 1, 2 is thin enough for its Heron area to cancel out, although its cross product is well above
+    // epsilon; the floating point test counts it as degenerate, like the original mesh did
+    auto const coords = std::make_shared<std::vector<Vec2> const>(
+        std::vector<Vec2>{{0, 0}, {1000, 0}, {500, 1e-6}, {500, -1}});
+    EXPECT_EQ(orient2d_inexact((*coords)[0], (*coords)[1], (*coords)[2]), 1);
+    EXPECT_EQ(orient2d_inexact((*coords)[0], (*coords)[1], (*coords)[3]), -1);
+    EXPECT_FALSE(is_strictly_convex_quadrilateral(*coords, EdgeCell(0, 1), EdgeCell(2, 3), false));
+    EXPECT_FALSE(PointSetGeometry(coords).is_strictly_convex_quadrilateral(EdgeCell(0, 1), EdgeCell(2, 3)));
+}
+
+
+namespace
+{
+    // the tabulated predicates must agree with evaluating them on the fly
+    void check_geometry(std::shared_ptr<std::vector<Vec2> const> const& pts)
+    {
+        PointSetGeometry const geometry(pts);
+        auto const&            coords = *pts;
+        bool const             exact  = has_integral_coordinates(coords);
+        ASSERT_EQ(geometry.exact(), exact);
+        ASSERT_EQ(geometry.size(), coords.size());
+
+        size_t const n = coords.size();
+        for(size_t a = 0; a < n; ++a)
+        {
+            for(size_t b = 0; b < n; ++b)
+            {
+                for(size_t c = 0; c < n; ++c)
+                    ASSERT_EQ(geometry.orientation(a, b, c), orient2d(coords[a], coords[b], coords[c], exact));
+            }
+        }
+
+        std::mt19937 rng(1);
+        for(size_t i = 0; i < 1000; ++i)
+        {
+            EdgeCell const edge(rng() % n, rng() % n);
+            EdgeCell const opposite(rng() % n, rng() % n);
+            ASSERT_EQ(geometry.is_strictly_convex_quadrilateral(edge, opposite),
+                      is_strictly_convex_quadrilateral(coords, edge, opposite, exact));
+        }
+    }
+} // namespace
+
+
+TEST(PointSetGeometry, MatchesTheDirectPredicates)
+{
+    check_geometry(test::point_set_2(18));
+    check_geometry(test::lattice(42, 7));
+
+    auto scaled = std::make_shared<std::vector<Vec2>>();
+    for(Vec2 const& p: *test::random_points(30, 1))
+        scaled->emplace_back(p.x / 7, p.y / 3);
+    check_geometry(scaled);
+
+    // above max_table_points the predicates are evaluated on the fly
+    check_geometry(test::random_points(PointSetGeometry::max_table_points + 2, 2));
+}
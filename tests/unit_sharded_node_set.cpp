@@ -0,0 +1,107 @@
+#include "mesh_triangulation_2d_bitset.h"
+#include "test_point_sets.h"
+#include "triangulation_flip_graph.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+    using Mesh    = MeshTriangulation2DBitset<16>;
+    using NodeSet = ShardedMeshNodeSet<Mesh>;
+
+    // all triangulations of point_set_2(9), each stored twice so that every one has an equal copy at another address
+    std::vector<Mesh> meshes_with_copies()
+    {
+        TriangulationFlipGraph<Mesh> graph(test::point_set_2(9));
+        graph.generate_graph();
+
+        std::vector<Mesh> res;
+        for(Mesh const* node: graph.nodes())
+            res.push_back(*node);
+        size_t const n = res.size();
+        for(size_t i = 0; i < n; ++i)
+            res.push_back(res[i]);
+        return res;
+    }
+} // namespace
+
+
+TEST(ShardedNodeSet, InsertFindAndIterate)
+{
+    auto const   meshes = meshes_with_copies();
+    size_t const n      = meshes.size() / 2;
+
+    // few shards, so that every shard grows well past its initial capacity
+    NodeSet set(2);
+    for(size_t i = 0; i < n; ++i)
+    {
+        EXPECT_EQ(set.find(&meshes[i]), set.end());
+        auto const [it, inserted] = set.insert(&meshes[i]);
+        EXPECT_TRUE(inserted);
+        EXPECT_EQ(*it, &meshes[i]);
+    }
+    EXPECT_EQ(set.size(), n);
+
+    // an equal triangulation at another address finds the stored node
+    for(size_t i = n; i < meshes.size(); ++i)
+    {
+        auto const [it, inserted] = set.insert(&meshes[i]);
+        EXPECT_FALSE(inserted);
+        EXPECT_EQ(*it, &meshes[i - n]);
+        EXPECT_EQ(*set.find(&meshes[i]), &meshes[i - n]);
+    }
+    EXPECT_EQ(set.size(), n);
+
+    std::set<Mesh const*> const walked(set.begin(), set.end());
+    EXPECT_EQ(walked.size(), n);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.begin(), set.end());
+}
+
+
+TEST(ShardedNodeSet, ConcurrentInsertKeepsOneCopy)
+{
+    auto const   meshes = meshes_with_copies();
+    size_t const n      = meshes.size() / 2;
+
+    // every thread inserts every triangulation, exactly one insertion of each must win
+    NodeSet                  set(4);
+    std::vector<size_t>      wins(4, 0);
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < wins.size(); ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for(size_t i = 0; i < n; ++i)
+                    wins[t] += set.insert(&meshes[(i + t * n / 4) % n + (t % 2) * n]).second;
+            });
+    }
+    for(auto& thread: threads)
+        thread.join();
+
+    size_t total = 0;
+    for(size_t const w: wins)
+        total += w;
+    EXPECT_EQ(total, n);
+    EXPECT_EQ(set.size(), n);
+}
+
+
+TEST(ShardedNodeSet, FlipGraphNodeCount)
+{
+    for(size_t const num_threads: {1, 4})
+    {
+        ConcurrentTriangulationFlipGraph<Mesh, FlipGraphShardedTraits> graph(test::point_set_2(12));
+        graph.generate_graph(num_threads);
+        EXPECT_EQ(graph.nodes().size(), 4719u) << num_threads << " threads";
+        EXPECT_EQ(graph.num_edges(), 18936u) << num_threads << " threads";
+    }
+}
@@ -0,0 +1,97 @@
+#include "mesh_triangulation_2d.h"
+#include "mesh_triangulation_2d_bitset.h"
+#include "point_set_crossings.h"
+#include "test_point_sets.h"
+#include "triangulation_crossings.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+
+namespace
+{
+    // flip random edges of a triangulation, checking the crossing queries against its neighbours at every step
+    template<class Mesh>
+    void check_flip_neighbours(std::shared_ptr<std::vector<Vec2> const> const& pts, size_t num_steps)
+    {
+        Mesh mesh(pts);
+        ASSERT_EQ(mesh.triangulate(), Mesh::Result::Success);
+        PointSetCrossings const crossings(mesh.geometry());
+
+        std::mt19937 rng(1);
+        for(size_t step = 0; step < num_steps; ++step)
+        {
+            // the edges of a triangulation never cross each other
+            ASSERT_EQ(count_crossing_pairs(crossings, mesh, mesh), 0u);
+            ASSERT_EQ(flip_distance_lower_bound(mesh, mesh), 0u);
+
+            // a flip replaces one edge by the other diagonal of its quadrilateral, which crosses it and nothing else
+            for(EdgeCell const edge: mesh.flippable())
+            {
+                EdgeCell const diagonal = mesh.opposite_edge(edge);
+                ASSERT_TRUE(crossings.crosses(edge, diagonal));
+                ASSERT_TRUE(is_flip_of(crossings, mesh, edge, diagonal));
+
+                Mesh neighbour = mesh;
+                ASSERT_EQ(neighbour.flip_edge(edge), Mesh::Result::Success);
+                ASSERT_EQ(count_crossing_pairs(crossings, mesh, neighbour), 1u);
+                ASSERT_EQ(flip_distance_lower_bound(mesh, neighbour), 1u);
+                ASSERT_FALSE(is_flip_of(crossings, neighbour, edge, diagonal));
+            }
+
+            EdgeCell const edge = test::random_flippable(mesh, rng);
+            ASSERT_EQ(mesh.flip_edge(edge), Mesh::Result::Success);
+        }
+    }
+} // namespace
+
+
+TEST(PointSetCrossings, TableMatchesOrientations)
+{
+    auto const              pts      = test::point_set_1(19);
+    auto const              geometry = std::make_shared<PointSetGeometry const>(pts);
+    PointSetCrossings const crossings(geometry);
+    ASSERT_TRUE(crossings.has_table());
+
+    size_t const n     = pts->size();
+    bool const   exact = geometry->exact();
+    for(size_t b = 1; b < n; ++b)
+    {
+        for(size_t a = 0; a < b; ++a)
+        {
+            EdgeCell const  lhs(a, b);
+            uint64_t const* row = crossings.row(lhs);
+            for(size_t d = 1; d < n; ++d)
+            {
+                for(size_t c = 0; c < d; ++c)
+                {
+                    EdgeCell const rhs(c, d);
+                    size_t const   idx      = rhs.index();
+                    bool const     disjoint = a != c && a != d && b != c && b != d;
+                    bool const     crosses  = disjoint && is_strictly_convex_quadrilateral(*pts, lhs, rhs, exact);
+                    ASSERT_EQ(crossings.crosses(lhs, rhs), crosses);
+                    ASSERT_EQ(((row[idx / 64] >> (idx % 64)) & 1u) != 0, crosses);
+                }
+            }
+        }
+    }
+
+    // (0, 4) runs along the border through (0, 1)
+    EXPECT_FALSE(crossings.admissible(EdgeCell(0, 4)));
+    EXPECT_TRUE(crossings.admissible(EdgeCell(0, 1)));
+    EXPECT_TRUE(crossings.admissible(EdgeCell(0, 3)));
+}
+
+
+TEST(TriangulationCrossings, FlipNeighbours)
+{
+    check_flip_neighbours<MeshTriangulation2DBitset<64>>(test::point_set_1(19), 50);
+    check_flip_neighbours<MeshTriangulation2DBitset<64>>(test::point_set_2(18), 50);
+
+    // above max_table_points the crossings are evaluated on the fly
+    auto const pts = test::lattice(PointSetCrossings::max_table_points + 6, 10);
+    ASSERT_FALSE(PointSetCrossings(std::make_shared<PointSetGeometry const>(pts)).has_table());
+    check_flip_neighbours<MeshTriangulation2D<>>(pts, 5);
+}
@@ -0,0 +1,205 @@
+#include "mesh_triangulation_2d.h"
+#include "mesh_triangulation_2d_bitset.h"
+#include "test_point_sets.h"
+#include "triangulation_flip_graph.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+
+TEST(TriangulationFlipGraph, NodeEqualityComparesFingerprintsFirst)
+{
+    using Mesh = MeshTriangulation2DBitset<16>;
+
+    auto start = std::make_unique<Mesh>(test::point_set_2(12));
+    ASSERT_EQ(start->triangulate(), Mesh::Result::Success);
+    auto flipped = std::make_unique<Mesh>(*start);
+    ASSERT_EQ(flipped->flip_edge(*start->flippable().begin()), Mesh::Result::Success);
+
+    std::unique_ptr<Mesh const> const lhs(std::move(start));
+    std::unique_ptr<Mesh const> const rhs(std::move(flipped));
+    std::unique_ptr<Mesh const> const copy(std::make_unique<Mesh>(*lhs));
+
+    MeshTriangulation2DCRefEqualTo const equal_to;
+    EXPECT_TRUE(equal_to(lhs, copy));
+    EXPECT_FALSE(equal_to(lhs, rhs));
+    EXPECT_NE(lhs->fingerprint(), rhs->fingerprint());
+    EXPECT_EQ(MeshTriangulation2DCRefHash{}(lhs), lhs->fingerprint().lo);
+}
+
+
+TEST(ScopedFlip, RestoresTheTriangulation)
+{
+    using Mesh = MeshTriangulation2D<>;
+
+    Mesh mesh(test::point_set_1(19));
+    ASSERT_EQ(mesh.triangulate(), Mesh::Result::Success);
+    Mesh const original = mesh;
+
+    for(EdgeCell const edge: original.flippable())
+    {
+        {
+            ScopedFlip<Mesh> const flip(mesh, edge);
+            ASSERT_TRUE(flip);
+            EXPECT_EQ(flip.flipped_edge(), original.opposite_edge(edge));
+            EXPECT_NE(mesh.fingerprint(), original.fingerprint());
+        }
+        ASSERT_EQ(mesh.fingerprint(), original.fingerprint());
+        ASSERT_TRUE(mesh == original);
+    }
+
+    // a failed flip leaves the mesh untouched and has nothing to restore
+    ScopedFlip<Mesh> const border(mesh, EdgeCell(0, 1));
+    EXPECT_FALSE(border);
+    EXPECT_TRUE(mesh == original);
+}
+
+TEST(ConcurrentTriangulationFlipGraph, NodeCountMatchesSequentialEngine)
+{
+    // every worker must keep going until the whole graph is explored, not stop at the first empty queue
+    for(size_t const num_threads: {1, 2, 4, 8})
+    {
+        ConcurrentTriangulationFlipGraph<MeshTriangulation2DBitset<16>> graph(test::point_set_2(12));
+        graph.generate_graph(num_threads);
+        EXPECT_EQ(graph.nodes().size(), 4719u) << num_threads << " threads";
+        EXPECT_EQ(graph.edges().size(), 18936u) << num_threads << " threads";
+
+        ConcurrentTriangulationFlipGraph<MeshTriangulation2D<>> lattice(test::lattice(12, 4));
+        lattice.generate_graph(num_threads);
+        EXPECT_EQ(lattice.nodes().size(), 852u) << num_threads << " threads";
+        EXPECT_EQ(lattice.edges().size(), 2626u) << num_threads << " threads";
+    }
+}
+
+
+TEST(ConcurrentTriangulationFlipGraph, BulkDequeueNodeCount)
+{
+    for(size_t const batch_size: {4, 32, 256})
+    {
+        ConcurrentTriangulationFlipGraph<MeshTriangulation2DBitset<16>> graph(test::point_set_2(12));
+        graph.generate_graph(4, batch_size);
+        EXPECT_EQ(graph.nodes().size(), 4719u) << "batch size " << batch_size;
+        EXPECT_EQ(graph.edges().size(), 18936u) << "batch size " << batch_size;
+    }
+}
+
+
+TEST(WorkStealingTriangulationFlipGraph, NodeCountMatchesSequentialEngine)
+{
+    for(size_t const num_threads: {1, 2, 4, 8})
+    {
+        WorkStealingTriangulationFlipGraph<MeshTriangulation2DBitset<16>> graph(test::point_set_2(12));
+        graph.generate_graph(num_threads);
+        EXPECT_EQ(graph.nodes().size(), 4719u) << num_threads << " threads";
+        EXPECT_EQ(graph.edges().size(), 18936u) << num_threads << " threads";
+
+        WorkStealingTriangulationFlipGraph<MeshTriangulation2D<>> lattice(test::lattice(12, 4));
+        lattice.generate_graph(num_threads);
+        EXPECT_EQ(lattice.nodes().size(), 852u) << num_threads << " threads";
+        EXPECT_EQ(lattice.edges().size(), 2626u) << num_threads << " threads";
+    }
+}
+
+
+TEST(ConcurrentNodeTriangulationFlipGraph, NodeCountMatchesSequentialEngine)
+{
+    for(size_t const num_threads: {1, 4})
+    {
+        for(size_t const batch_size: {1, 16})
+        {
+            ConcurrentNodeTriangulationFlipGraph<MeshTriangulation2DBitset<16>> graph(test::point_set_2(12));
+            graph.generate_graph(num_threads, batch_size);
+            EXPECT_EQ(graph.nodes().size(), 4719u) << num_threads << " threads, batch size " << batch_size;
+            EXPECT_EQ(graph.edges().size(), 18936u) << num_threads << " threads, batch size " << batch_size;
+
+            ConcurrentNodeTriangulationFlipGraph<MeshTriangulation2D<>> lattice(test::lattice(12, 4));
+            lattice.generate_graph(num_threads, batch_size);
+            EXPECT_EQ(lattice.nodes().size(), 852u) << num_threads << " threads, batch size " << batch_size;
+            EXPECT_EQ(lattice.edges().size(), 2626u) << num_threads << " threads, batch size " << batch_size;
+        }
+    }
+}
+
+
+TEST(TriangulationFlipGraphCounter, CountsMatchTheFullGraph)
+{
+    TriangulationFlipGraphCounter<MeshTriangulation2DBitset<16>> counter(test::point_set_2(12));
+    FlipGraphCounts const&                                       counts = counter.count();
+    EXPECT_EQ(counts.num_nodes, 4719u);
+    EXPECT_EQ(counts.num_edges, 18936u);
+
+    // every node is in one bucket, every edge is seen from both of its endpoints
+    size_t num_nodes = 0;
+    size_t sum_deg   = 0;
+    for(size_t d = 0; d < counts.degree_histogram.size(); ++d)
+    {
+        num_nodes += counts.degree_histogram[d];
+        sum_deg += d * counts.degree_histogram[d];
+    }
+    EXPECT_EQ(num_nodes, counts.num_nodes);
+    EXPECT_EQ(sum_deg, 2 * counts.num_edges);
+
+    TriangulationFlipGraphCounter<MeshTriangulation2D<>> lattice(test::lattice(12, 4));
+    EXPECT_EQ(lattice.count().num_nodes, 852u);
+    EXPECT_EQ(lattice.counts().num_edges, 2626u);
+}
+
+
+template<class GraphTraits>
+class FlipGraphTraitsTest : public ::testing::Test
+{};
+
+using GraphTraitsTypes = ::testing::Types<FlipGraphDefaultTraits, FlipGraphShardedTraits, FlipGraphWorkStealingTraits,
+                                         FlipGraphShardedWorkStealingTraits>;
+TYPED_TEST_SUITE(FlipGraphTraitsTest, GraphTraitsTypes);
+
+
+TYPED_TEST(FlipGraphTraitsTest, ConcurrentEnginesCounts)
+{
+    for(size_t const num_threads: {1, 4})
+    {
+        ConcurrentTriangulationFlipGraph<MeshTriangulation2DBitset<16>, TypeParam> graph(test::point_set_2(12));
+        graph.generate_graph(num_threads);
+        EXPECT_EQ(graph.nodes().size(), 4719u) << num_threads << " threads";
+        EXPECT_EQ(graph.num_edges(), 18936u) << num_threads << " threads";
+
+        ConcurrentNodeTriangulationFlipGraph<MeshTriangulation2D<>, TypeParam> node(test::lattice(12, 4),
+                                                                                   FlipGraphEdgeMode::CanonicalOwner);
+        node.generate_graph(num_threads);
+        EXPECT_EQ(node.nodes().size(), 852u) << num_threads << " threads";
+        EXPECT_EQ(node.num_edges(), 2626u) << num_threads << " threads";
+    }
+}
+
+
+TEST(TriangulationFlipGraph, DelaunaySeedCounts)
+{
+    auto const pts = test::point_set_2(12);
+
+    TriangulationFlipGraph<MeshTriangulation2DBitset<16>> sequential(pts, FlipGraphEdgeMode::Deduplicated,
+                                                                     FlipGraphSeed::Delaunay);
+    sequential.generate_graph();
+    EXPECT_EQ(sequential.nodes().size(), 4719u);
+    EXPECT_EQ(sequential.num_edges(), 18936u);
+
+    ConcurrentTriangulationFlipGraph<MeshTriangulation2D<>> concurrent(test::lattice(12, 4),
+                                                                       FlipGraphEdgeMode::CanonicalOwner,
+                                                                       FlipGraphSeed::Delaunay);
+    concurrent.generate_graph(4);
+    EXPECT_EQ(concurrent.nodes().size(), 852u);
+    EXPECT_EQ(concurrent.num_edges(), 2626u);
+
+    TriangulationFlipGraphCounter<MeshTriangulation2DBitset<16>> counter(pts, FlipGraphSeed::Delaunay);
+    EXPECT_EQ(counter.count().num_nodes, 4719u);
+    EXPECT_EQ(counter.counts().num_edges, 18936u);
+}
+
+
+TEST(TriangulationFlipGraph, ReserveHintIsClamped)
+{
+    EXPECT_EQ(detail::reserve_hint(4), size_t{1} << 12);
+    EXPECT_EQ(detail::reserve_hint(11), size_t{1} << 19);
+    EXPECT_EQ(detail::reserve_hint(12), detail::max_reserve_hint);
+    EXPECT_EQ(detail::reserve_hint(64), detail::max_reserve_hint);
+}
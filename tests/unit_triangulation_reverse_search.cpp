@@ -0,0 +1,169 @@
+#include "delaunay.h"
+#include "mesh_triangulation_2d.h"
+#include "mesh_triangulation_2d_bitset.h"
+#include "mesh_triangulation_2d_fixed.h"
+#include "mesh_triangulation_2d_half_edge.h"
+#include "test_point_sets.h"
+#include "triangulation_reverse_search.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+
+TEST(Delaunay, CocircularSquareHasOneLegalDiagonal)
+{
+    auto const                    pts = test::lattice(4, 2);
+    MeshTriangulation2DBitset<16> mesh(pts);
+    ASSERT_EQ(mesh.triangulate(), MeshTriangulation2DBitset<16>::Result::Success);
+    ASSERT_EQ(mesh.flippable().size(), 1u);
+
+    // the perturbation breaks the tie between the two diagonals of the square
+    EdgeCell const diagonal = *mesh.flippable().begin();
+    bool const     illegal  = is_illegal_edge(mesh, *pts, diagonal);
+    EdgeCell const other    = mesh.opposite_edge(diagonal);
+    ASSERT_EQ(mesh.flip_edge(diagonal), MeshTriangulation2DBitset<16>::Result::Success);
+    EXPECT_NE(is_illegal_edge(mesh, *pts, other), illegal);
+}
+
+
+TEST(Delaunay, IncircleIsExactForIntegralCoordinates)
+{
+    // four points near a circle of radius 2^28: d lies outside the circumcircle, but the floating point determinant
+    // cancels out to zero and would leave the decision to the perturbation
+    std::vector<Vec2> const coords = {{-179172602, 162061191},
+                                      {237670232, 43353341},
+                                      {-45169822, 237331705},
+                                      {-180941570, -160083726}};
+    ASSERT_TRUE(has_integral_coordinates(coords));
+    ASSERT_EQ(orient2d_exact(coords[0], coords[1], coords[2]), 1);
+
+    EXPECT_EQ(incircle_exact(coords[0], coords[1], coords[2], coords[3]), -1);
+    EXPECT_FALSE(in_circumcircle_perturbed(coords, 0, 1, 2, 3, true));
+
+    // the square of the lattice is cocircular, both predicates leave it to the perturbation
+    std::vector<Vec2> const square = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+    EXPECT_EQ(incircle_exact(square[0], square[1], square[2], square[3]), 0);
+    EXPECT_EQ(incircle_inexact(square[0], square[1], square[2], square[3]), 0);
+    EXPECT_EQ(in_circumcircle_perturbed(square, 0, 1, 2, 3, true),
+              in_circumcircle_perturbed(square, 0, 1, 2, 3, false));
+}
+
+
+TEST(Delaunay, LawsonFlipsReachTheDelaunayTriangulation)
+{
+    for(auto const& pts: {test::point_set_2(12), test::lattice(42, 7)})
+    {
+        MeshTriangulation2DBitset<64> mesh(pts);
+        ASSERT_EQ(mesh.triangulate(), MeshTriangulation2DBitset<64>::Result::Success);
+        lawson_flip_to_delaunay(mesh, *pts);
+
+        EXPECT_TRUE(lawson_flip_edge(mesh, *pts).undefined());
+        for(EdgeCell const edge: mesh.flippable())
+            EXPECT_FALSE(is_illegal_edge(mesh, *pts, edge));
+    }
+}
+
+
+TEST(Delaunay, SameTriangulationForEveryMesh)
+{
+    for(auto const& pts: {test::point_set_2(18), test::lattice(42, 7), test::random_points(60, 1)})
+    {
+        MeshTriangulation2D<> reference(pts);
+        ASSERT_EQ(reference.triangulate(), MeshTriangulation2D<>::Result::Success);
+        reference.make_delaunay();
+
+        MeshTriangulation2DBitset<64> bitset(pts);
+        ASSERT_EQ(bitset.triangulate(), MeshTriangulation2D<>::Result::Success);
+        lawson_flip_to_delaunay(bitset, *pts);
+        EXPECT_EQ(bitset.fingerprint(), reference.fingerprint());
+
+        auto const                   geometry = std::make_shared<PointSetGeometry const>(pts);
+        MeshTriangulation2DFixed<64> fixed(geometry);
+        ASSERT_EQ(fixed.triangulate(), MeshTriangulation2D<>::Result::Success);
+        lawson_flip_to_delaunay(fixed, *pts);
+        EXPECT_EQ(fixed.fingerprint(), reference.fingerprint());
+
+        MeshTriangulation2DHalfEdge half_edge(pts);
+        ASSERT_EQ(half_edge.triangulate(), MeshTriangulation2D<>::Result::Success);
+        lawson_flip_to_delaunay(half_edge, *pts);
+        EXPECT_EQ(half_edge.fingerprint(), reference.fingerprint());
+    }
+}
+
+TEST(ReverseSearchTriangulationEnumerator, VisitsEveryTriangulationOnce)
+{
+    ReverseSearchTriangulationEnumerator<MeshTriangulation2DBitset<16>> enumerator(test::point_set_2(12));
+
+    std::set<std::pair<uint64_t, uint64_t>> visited;
+    enumerator.enumerate([&](MeshTriangulation2DBitset<16> const& mesh)
+                         { EXPECT_TRUE(visited.emplace(mesh.fingerprint().lo, mesh.fingerprint().hi).second); });
+    EXPECT_EQ(visited.size(), 4719u);
+    EXPECT_EQ(enumerator.num_nodes(), 4719u);
+    EXPECT_EQ(enumerator.num_edges(), 18936u);
+}
+
+
+TEST(ReverseSearchTriangulationEnumerator, CollinearPoints)
+{
+    ReverseSearchTriangulationEnumerator<MeshTriangulation2D<>> enumerator(test::lattice(12, 4));
+    for(int run = 0; run < 2; ++run)
+    {
+        enumerator.enumerate();
+        EXPECT_EQ(enumerator.num_nodes(), 852u);
+        EXPECT_EQ(enumerator.num_edges(), 2626u);
+    }
+}
+
+
+TEST(ParallelReverseSearchTriangulationEnumerator, CountsMatchSequentialEnumerator)
+{
+    for(size_t const num_threads: {1, 2, 4, 8})
+    {
+        for(size_t const budget: {1, 64, 4096})
+        {
+            ParallelReverseSearchTriangulationEnumerator<MeshTriangulation2DBitset<16>> enumerator(
+                test::point_set_2(12));
+            enumerator.enumerate(num_threads, budget);
+            EXPECT_EQ(enumerator.num_nodes(), 4719u) << num_threads << " threads, budget " << budget;
+            EXPECT_EQ(enumerator.num_edges(), 18936u) << num_threads << " threads, budget " << budget;
+        }
+    }
+
+    ParallelReverseSearchTriangulationEnumerator<MeshTriangulation2D<>> lattice(test::lattice(14, 4));
+    lattice.enumerate(size_t{4}, size_t{64});
+    EXPECT_EQ(lattice.num_nodes(), 6672u);
+    EXPECT_EQ(lattice.num_edges(), 26172u);
+}
+
+
+TEST(ParallelReverseSearchTriangulationEnumerator, VisitsEveryTriangulationOnce)
+{
+    ParallelReverseSearchTriangulationEnumerator<MeshTriangulation2DBitset<16>> enumerator(test::point_set_2(12));
+
+    std::mutex                              mutex;
+    std::set<std::pair<uint64_t, uint64_t>> visited;
+    enumerator.enumerate(
+        [&](MeshTriangulation2DBitset<16> const& mesh, size_t)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            EXPECT_TRUE(visited.emplace(mesh.fingerprint().lo, mesh.fingerprint().hi).second);
+        },
+        4, 16);
+    EXPECT_EQ(visited.size(), 4719u);
+}
+
+
+TEST(ParallelReverseSearchTriangulationEnumerator, IntegerArgumentsSelectTheCountingOverload)
+{
+    // int literals must not bind to the visitor overload
+    ParallelReverseSearchTriangulationEnumerator<MeshTriangulation2DBitset<16>> enumerator(test::lattice(12, 4));
+    enumerator.enumerate(8, 16);
+    EXPECT_EQ(enumerator.num_nodes(), 852u);
+    EXPECT_EQ(enumerator.num_edges(), 2626u);
+}
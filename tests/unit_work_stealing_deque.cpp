@@ -0,0 +1,105 @@
+#include "utils/work_stealing_deque.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+TEST(WorkStealingDeque, OwnerPopsNewestThievesStealOldest)
+{
+    WorkStealingDeque<int> deque;
+    for(int i = 0; i < 4; ++i)
+        deque.push(i);
+
+    int value = -1;
+    ASSERT_TRUE(deque.try_pop(value));
+    EXPECT_EQ(value, 3);
+    ASSERT_TRUE(deque.try_steal(value));
+    EXPECT_EQ(value, 0);
+    ASSERT_TRUE(deque.try_pop(value));
+    EXPECT_EQ(value, 2);
+    ASSERT_TRUE(deque.try_steal(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(deque.try_pop(value));
+    EXPECT_FALSE(deque.try_steal(value));
+}
+
+
+TEST(WorkStealingDeque, EveryItemIsTakenOnce)
+{
+    constexpr int num_items   = 200000;
+    constexpr int num_thieves = 3;
+
+    WorkStealingDeque<int>        deque;
+    std::vector<std::atomic<int>> taken(num_items);
+    std::atomic<bool>             done{false};
+    std::vector<std::thread>      thieves;
+    for(int t = 0; t < num_thieves; ++t)
+    {
+        thieves.emplace_back(
+            [&]
+            {
+                int value = 0;
+                while(!done.load(std::memory_order_acquire))
+                {
+                    if(deque.try_steal(value))
+                        taken[value].fetch_add(1, std::memory_order_relaxed);
+                }
+                while(deque.try_steal(value))
+                    taken[value].fetch_add(1, std::memory_order_relaxed);
+            });
+    }
+
+    // the owner alternates between pushing and popping, racing with the thieves on the last items
+    int value = 0;
+    for(int i = 0; i < num_items; ++i)
+    {
+        deque.push(i);
+        if(i % 3 == 0 && deque.try_pop(value))
+            taken[value].fetch_add(1, std::memory_order_relaxed);
+    }
+    while(deque.try_pop(value))
+        taken[value].fetch_add(1, std::memory_order_relaxed);
+    done.store(true, std::memory_order_release);
+    for(auto& thief: thieves)
+        thief.join();
+
+    for(int i = 0; i < num_items; ++i)
+        ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+}
+
+
+TEST(WorkStealingDeque, GrowsWithMultiWordItems)
+{
+    // larger than a word and not a multiple of one, like the BFS states of the engines
+    struct Item
+    {
+        uint64_t lo;
+        uint64_t hi;
+        uint32_t tag;
+    };
+
+    WorkStealingDeque<Item> deque(4);
+    std::vector<Item>       items;
+    for(uint32_t i = 0; i < 1000; ++i)
+        items.push_back(Item{i, ~uint64_t{i}, i * 7});
+    deque.push_bulk(items.begin(), items.begin() + 3);
+    deque.push_bulk(items.begin() + 3, items.end());
+
+    Item item{};
+    ASSERT_TRUE(deque.try_steal(item));
+    EXPECT_EQ(item.lo, 0u);
+    ASSERT_TRUE(deque.try_pop(item));
+    EXPECT_EQ(item.lo, 999u);
+    EXPECT_EQ(item.hi, ~uint64_t{999});
+    EXPECT_EQ(item.tag, 999u * 7);
+
+    std::vector<Item> popped(2000);
+    EXPECT_EQ(deque.try_pop_bulk(popped.begin(), popped.size()), 998u);
+    EXPECT_EQ(popped.front().lo, 998u);
+    EXPECT_EQ(popped[997].lo, 1u);
+    EXPECT_FALSE(deque.try_steal(item));
+}